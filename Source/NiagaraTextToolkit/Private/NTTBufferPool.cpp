@@ -0,0 +1,127 @@
+// Property of Lucian Tranc
+
+#include "NTTBufferPool.h"
+#include "NTTDataInterface.h"
+#include "NTTCompat.h"
+#include "RHICommandList.h"
+#include "RenderingThread.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarNTTBufferPoolMaxSizeKB(
+	TEXT("NTT.BufferPool.MaxSizeKB"),
+	4096,
+	TEXT("Memory budget in KB for unused NTT GPU buffers kept for reuse. Buffers released while the pool is over it are freed. 0 disables pooling."),
+	ECVF_RenderThreadSafe);
+
+FNTTBufferPool& FNTTBufferPool::Get()
+{
+	static FNTTBufferPool Instance;
+	return Instance;
+}
+
+uint32 FNTTBufferPool::GetSizeClass(uint32 NumBytes)
+{
+	return FMath::CeilLogTwo(FMath::Max(NumBytes, MinBufferBytes));
+}
+
+FRWBufferStructured FNTTBufferPool::Acquire(FRHICommandListBase& RHICmdList, const TCHAR* DebugName, uint32 BytesPerElement, uint32 NumElements)
+{
+	check(IsInRenderingThread());
+	check(FMath::IsPowerOfTwo(BytesPerElement));
+
+	const uint32 SizeClass = GetSizeClass(BytesPerElement * NumElements);
+	TArray<FRWBufferStructured>& Free = FreeBuffers[SizeClass];
+	for (int32 FreeIdx = Free.Num() - 1; FreeIdx >= 0; --FreeIdx)
+	{
+		// A size class holds every stride, and a structured buffer's views are tied to the stride it was created with
+		if (Free[FreeIdx].Buffer->GetStride() == BytesPerElement)
+		{
+			FRWBufferStructured Buffer = Free[FreeIdx];
+			Free.RemoveAtSwap(FreeIdx, 1, NTT_NO_SHRINK);
+			++Stats.Hits;
+			Stats.PooledBytes -= Buffer.NumBytes;
+			--Stats.NumPooledBuffers;
+			return Buffer;
+		}
+	}
+
+	FRWBufferStructured Buffer;
+	Buffer.Initialize(RHICmdList, DebugName, BytesPerElement, (1u << SizeClass) / BytesPerElement, BUF_ShaderResource | BUF_Static);
+	++Stats.Misses;
+	Stats.ResidentBytes += Buffer.NumBytes;
+	return Buffer;
+}
+
+void FNTTBufferPool::Release(FRWBufferStructured& Buffer)
+{
+	check(IsInRenderingThread());
+
+	if (!Buffer.Buffer.IsValid())
+	{
+		return;
+	}
+
+	const uint64 MaxPooledBytes = static_cast<uint64>(FMath::Max(CVarNTTBufferPoolMaxSizeKB.GetValueOnRenderThread(), 0)) * 1024;
+	if (Stats.PooledBytes + Buffer.NumBytes <= MaxPooledBytes)
+	{
+		// Buffers from Acquire are exactly one size class, so they go back to the bucket they came from.
+		FreeBuffers[GetSizeClass(Buffer.NumBytes)].Add(Buffer);
+		Stats.PooledBytes += Buffer.NumBytes;
+		++Stats.NumPooledBuffers;
+	}
+	else
+	{
+		Stats.ResidentBytes -= Buffer.NumBytes;
+	}
+
+	// Drops this reference; a pooled copy keeps the RHI buffer alive.
+	Buffer.Release();
+}
+
+void FNTTBufferPool::Empty()
+{
+	check(IsInRenderingThread());
+
+	for (TArray<FRWBufferStructured>& Free : FreeBuffers)
+	{
+		for (FRWBufferStructured& Buffer : Free)
+		{
+			Stats.ResidentBytes -= Buffer.NumBytes;
+			Buffer.Release();
+		}
+		Free.Empty();
+	}
+	Stats.PooledBytes = 0;
+	Stats.NumPooledBuffers = 0;
+}
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommand GNTTBufferPoolStatsCommand(
+	TEXT("NTT.BufferPool.Stats"),
+	TEXT("Logs how often NTT GPU buffers were reused from the pool, and how much memory the pool's buffers hold."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		ENQUEUE_RENDER_COMMAND(NTTBufferPoolStats)([](FRHICommandListImmediate& RHICmdList)
+		{
+			const FNTTBufferPool::FStats& Stats = FNTTBufferPool::Get().GetStats();
+			const uint64 Acquires = Stats.Hits + Stats.Misses;
+			UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT Buffer Pool: %llu hits, %llu misses (%.1f%% reused), %.1f KB resident, %.1f KB in %d pooled buffers"),
+				Stats.Hits, Stats.Misses, Acquires > 0 ? 100.0 * Stats.Hits / Acquires : 0.0,
+				Stats.ResidentBytes / 1024.0, Stats.PooledBytes / 1024.0, Stats.NumPooledBuffers);
+		});
+	}));
+
+static FAutoConsoleCommand GNTTBufferPoolFlushCommand(
+	TEXT("NTT.BufferPool.Flush"),
+	TEXT("Frees every unused NTT GPU buffer kept in the pool. Buffers in use are unaffected."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		ENQUEUE_RENDER_COMMAND(NTTBufferPoolFlush)([](FRHICommandListImmediate& RHICmdList)
+		{
+			FNTTBufferPool::Get().Empty();
+			UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT Buffer Pool: Flushed"));
+		});
+	}));
+
+#endif
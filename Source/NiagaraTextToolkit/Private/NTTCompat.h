@@ -0,0 +1,12 @@
+// Property of Lucian Tranc
+
+#pragma once
+
+#include "Misc/EngineVersionComparison.h"
+
+// Container calls that keep their allocation take EAllowShrinking from 5.4 on; the bool overloads are deprecated there but are all 5.3 has.
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+#define NTT_NO_SHRINK false
+#else
+#define NTT_NO_SHRINK EAllowShrinking::No
+#endif
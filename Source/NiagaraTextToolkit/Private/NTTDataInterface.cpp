@@ -10,6 +10,7 @@
 #include "NiagaraDataInterfaceUtilities.h"
 #include "RHI.h"
 #include "VectorVM.h"
+#include "Misc/ScopeLock.h"
 
 DEFINE_LOG_CATEGORY(LogNiagaraTextToolkit);
 
@@ -17,90 +18,6 @@ DEFINE_LOG_CATEGORY(LogNiagaraTextToolkit);
 
 static const TCHAR* FontUVTemplateShaderFile = TEXT("/Plugin/NiagaraTextToolkit/Private/NTTDataInterface.ush");
 
-static bool IsWhitespaceChar(int32 Code)
-{
-	return Code == ' '
-		|| Code == '\t';
-}
-
-// Iterator that understands newlines and reports original source indices per character,
-struct FNTTTextIterator
-{
-	const FString& Source;
-	const int32 Length;
-	int32 CurrentIndex;
-
-	explicit FNTTTextIterator(const FString& InSource)
-		: Source(InSource)
-		, Length(InSource.Len())
-		, CurrentIndex(0)
-	{
-	}
-
-	// Returns true as long as we are not past the end of the string.
-	bool HasNextCharacter()
-	{
-		return CurrentIndex < Length;
-	}
-
-	// Returns the next character in the current logical line.
-	// Newline characters ('\n' and '\r' / "\r\n") are consumed but never returned.
-	bool NextCharacterInLine(int32& OutSourceIndex, TCHAR& OutChar)
-	{
-		if (CurrentIndex >= Length)
-		{
-			return false;
-		}
-
-		const TCHAR Ch = Source[CurrentIndex];
-
-		// Handle newlines as line separators, not drawable characters.
-		if (Ch == '\n')
-		{
-			++CurrentIndex;
-			return false;
-		}
-
-		if (Ch == '\r')
-		{
-			// Treat CRLF as a single newline.
-			if (CurrentIndex + 1 < Length && Source[CurrentIndex + 1] == '\n')
-			{
-				CurrentIndex += 2;
-			}
-			else
-			{
-				++CurrentIndex;
-			}
-			return false;
-		}
-
-		OutSourceIndex = CurrentIndex;
-		OutChar = Ch;
-		++CurrentIndex;
-		return true;
-	}
-
-	// Peek at the next character in the current logical line without advancing.
-	// Returns false at end-of-line or end-of-string.
-	bool PeekNextCharacterInLine(TCHAR& OutChar) const
-	{
-		if (CurrentIndex >= Length)
-		{
-			return false;
-		}
-
-		const TCHAR Ch = Source[CurrentIndex];
-		if (Ch == '\n' || Ch == '\r')
-		{
-			return false;
-		}
-
-		OutChar = Ch;
-		return true;
-	}
-};
-
 const FName UNTTDataInterface::GetCharacterUVName(TEXT("GetCharacterUV"));
 const FName UNTTDataInterface::GetCharacterPositionName(TEXT("GetCharacterPosition"));
 const FName UNTTDataInterface::GetTextCharacterCountName(TEXT("GetTextCharacterCount"));
@@ -114,6 +31,20 @@ const FName UNTTDataInterface::GetCharacterCountInWordRangeName(TEXT("GetCharact
 const FName UNTTDataInterface::GetCharacterCountInLineRangeName(TEXT("GetCharacterCountInLineRange"));
 const FName UNTTDataInterface::GetCharacterSpriteSizeName(TEXT("GetCharacterSpriteSize"));
 const FName UNTTDataInterface::GetTextHeightName(TEXT("GetTextHeight"));
+const FName UNTTDataInterface::GetCharacterPageName(TEXT("GetCharacterPage"));
+const FName UNTTDataInterface::GetCharacterColorName(TEXT("GetCharacterColor"));
+const FName UNTTDataInterface::GetCharacterScaleName(TEXT("GetCharacterScale"));
+const FName UNTTDataInterface::GetCharacterStyleName(TEXT("GetCharacterStyle"));
+const FName UNTTDataInterface::GetCharacterLineIndexName(TEXT("GetCharacterLineIndex"));
+const FName UNTTDataInterface::GetCharacterWordIndexName(TEXT("GetCharacterWordIndex"));
+const FName UNTTDataInterface::GetCharacterTransformName(TEXT("GetCharacterTransform"));
+const FName UNTTDataInterface::GetLineWidthName(TEXT("GetLineWidth"));
+const FName UNTTDataInterface::GetLineTopName(TEXT("GetLineTop"));
+const FName UNTTDataInterface::GetWordBoundsName(TEXT("GetWordBounds"));
+const FName UNTTDataInterface::GetTextBoundsName(TEXT("GetTextBounds"));
+const FName UNTTDataInterface::GetTextGenerationName(TEXT("GetTextGeneration"));
+const FName UNTTDataInterface::GetCharacterRecordName(TEXT("GetCharacterRecord"));
+const FName UNTTDataInterface::IsTextReadyName(TEXT("IsTextReady"));
 
 // Creates a new data object to store our data
 bool UNTTDataInterface::InitPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance)
@@ -121,451 +52,455 @@ bool UNTTDataInterface::InitPerInstanceData(void* PerInstanceData, FNiagaraSyste
 	TRACE_CPUPROFILER_EVENT_SCOPE(NTTDataInterface_InitPerInstanceData);
 
 	FNDIFontUVInfoInstanceData* InstanceData = new (PerInstanceData) FNDIFontUVInfoInstanceData;
-
-	TArray<FVector4> CharacterTextureUvs;
-	TArray<FVector2f> CharacterSpriteSizes;
-	TArray<int32> VerticalOffsets;
-	int32 Kerning = 0;
-	if (!GetFontInfo(FontAsset, CharacterTextureUvs, CharacterSpriteSizes, VerticalOffsets, Kerning))
-	{
-		UE_LOG(LogNiagaraTextToolkit, Warning, TEXT("NTT DI: Failed to get font info from FontAsset '%s'"), *GetNameSafe(FontAsset));
-	}
-	
-	float TotalTextHeight = 0.0f;
-	TArray<FVector2f> CharacterPositionsUnfiltered = GetCharacterPositions(CharacterSpriteSizes, VerticalOffsets, Kerning, VerticalOffset, KerningOffset, WhitespaceWidthMultiplier, InputText, HorizontalAlignment, VerticalAlignment, TotalTextHeight);
-	
-	TArray<int32> OutUnicode;
-	TArray<FVector2f> OutCharacterPositions;
-	TArray<int32> OutLineStartIndices;
-	TArray<int32> OutLineCharacterCounts;
-	TArray<int32> OutWordStartIndices;
-	TArray<int32> OutWordCharacterCounts;
-
-	if (CharacterPositionsUnfiltered.Num() == InputText.Len())
-	{
-		ProcessText(InputText, CharacterPositionsUnfiltered, bFilterWhitespaceCharacters, OutUnicode, OutCharacterPositions, OutLineStartIndices, OutLineCharacterCounts, OutWordStartIndices, OutWordCharacterCounts);
-	}
-
-	InstanceData->CharacterTextureUvs = MoveTemp(CharacterTextureUvs);
-	InstanceData->CharacterSpriteSizes = MoveTemp(CharacterSpriteSizes);
-	InstanceData->bFilterWhitespaceCharactersValue = bFilterWhitespaceCharacters;
-	InstanceData->Unicode = MoveTemp(OutUnicode);
-	InstanceData->CharacterPositions = MoveTemp(OutCharacterPositions);
-	InstanceData->LineStartIndices = MoveTemp(OutLineStartIndices);
-	InstanceData->LineCharacterCounts = MoveTemp(OutLineCharacterCounts);
-	InstanceData->WordStartIndices = MoveTemp(OutWordStartIndices);
-	InstanceData->WordCharacterCounts = MoveTemp(OutWordCharacterCounts);
-	InstanceData->TotalTextHeight = TotalTextHeight;
-
+	UpdateContent(*InstanceData);
 	return true;
 }
 
-bool UNTTDataInterface::GetFontInfo(const UFont* FontAsset, TArray<FVector4>& OutCharacterTextureUvs, TArray<FVector2f>& OutCharacterSpriteSizes, TArray<int32>& OutVerticalOffsets, int32& OutKerning)
+bool UNTTDataInterface::PerInstanceTick(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance, float DeltaSeconds)
 {
-	OutCharacterTextureUvs.Reset();
-	OutCharacterSpriteSizes.Reset();
-	OutVerticalOffsets.Reset();
-	OutKerning = 0;
+	FNDIFontUVInfoInstanceData* InstanceData = static_cast<FNDIFontUVInfoInstanceData*>(PerInstanceData);
 
-	// Only offline cached fonts have the Characters array populated
-	if (FontAsset && FontAsset->FontCacheType == EFontCacheType::Offline)
+	// Steady state is two atomic loads. New text, fonts and layout settings are picked up here rather than by reinitializing the system,
+	// which would throw away every particle.
+	if (ContentSerial.load(std::memory_order_acquire) != InstanceData->ContentSerial)
 	{
-		// Try to get the first font texture so we can normalize glyph UVs into 0-1 space.
-		const UTexture2D* FontTexture = nullptr;
-		if (FontAsset->Textures.Num() > 0)
-		{
-			FontTexture = Cast<UTexture2D>(FontAsset->Textures[0]);
-		}
+		UpdateContent(*InstanceData);
+	}
 
-		FVector2f InvTextureSize(1.0f, 1.0f);
-		if (FontTexture)
-		{
-			const float TexW = static_cast<float>(FontTexture->GetSizeX());
-			const float TexH = static_cast<float>(FontTexture->GetSizeY());
-			if (TexW > 0.0f && TexH > 0.0f)
-			{
-				InvTextureSize = FVector2f(1.0f / TexW, 1.0f / TexH);
-			}
-			else
-			{
-				UE_LOG(LogNiagaraTextToolkit, Warning,
-					TEXT("NTT DI: Font '%s' texture has invalid size (%f x %f) - UVs will not be normalized"),
-					*GetNameSafe(FontAsset), TexW, TexH);
-			}
-		}
-		else
-		{
-			UE_LOG(LogNiagaraTextToolkit, Warning,
-				TEXT("NTT DI: Font '%s' has no textures - UVs will not be normalized"),
-				*GetNameSafe(FontAsset));
-		}
+	// An async layout is swapped in on the first tick after it completes; until then the instance reports not ready.
+	if (InstanceData->PendingLayout.IsValid() && InstanceData->PendingLayout.IsCompleted())
+	{
+		FinishPendingLayout(*InstanceData);
+	}
 
-		// Copy data from FFontCharacter array to our arrays
-		const int32 NumCharacters = FontAsset->Characters.Num();
-		OutCharacterTextureUvs.Reserve(NumCharacters);
-		OutCharacterSpriteSizes.Reserve(NumCharacters);
-		OutVerticalOffsets.Reserve(NumCharacters);
+	// The number is only laid out again when SetNumber was called since the last tick.
+	const uint32 CurrentNumberSerial = NumberSerial.load(std::memory_order_acquire);
+	if (CurrentNumberSerial != 0 && CurrentNumberSerial != InstanceData->NumberSerial)
+	{
+		UpdateNumberLayout(*InstanceData);
+	}
 
-		for (const FFontCharacter& FontChar : FontAsset->Characters)
-		{
-			const float USizePx = static_cast<float>(FontChar.USize);
-			const float VSizePx = static_cast<float>(FontChar.VSize);
-			const float UStartPx = static_cast<float>(FontChar.StartU);
-			const float VStartPx = static_cast<float>(FontChar.StartV);
-
-			// Store sprite size in pixels for layout / particle sizing.
-			OutCharacterSpriteSizes.Add(FVector2f(USizePx, VSizePx));
-
-			// Precompute normalized UVs so shaders/materials don't have to divide by texture resolution.
-			const float USizeNorm  = USizePx  * InvTextureSize.X;
-			const float VSizeNorm  = VSizePx  * InvTextureSize.Y;
-			const float UStartNorm = UStartPx * InvTextureSize.X;
-			const float VStartNorm = VStartPx * InvTextureSize.Y;
-
-			// Layout: (USize, VSize, UStart, VStart) in 0-1 texture space.
-			OutCharacterTextureUvs.Add(FVector4(USizeNorm, VSizeNorm, UStartNorm, VStartNorm));
-			OutVerticalOffsets.Add(FontChar.VerticalOffset);
-		}
+	// Never needs a reset: the new layout reaches the render thread through the regular per-instance data path.
+	return false;
+}
 
-		OutKerning = FontAsset->Kerning;
-		return true;
+// Lays Text out, starting from a copy of PreviousLayout when there is one, and packs it for the GPU. Any thread.
+static FNTTTextLayoutPtr BuildLayout(const FNTTGlyphTablePtr& GlyphTable, const FNTTTextLayoutSettings& Settings, const FString& Text, const FNTTTextLayoutPtr& PreviousLayout)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NTTDataInterface_BuildLayout);
+
+	TSharedRef<FNTTTextLayout, ESPMode::ThreadSafe> NewLayout = FNTTTextLayoutEngine::AllocateLayout();
+	if (PreviousLayout.IsValid())
+	{
+		*NewLayout = *PreviousLayout;
+		FNTTTextLayoutEngine::Relayout(*GlyphTable, Settings, Text, *NewLayout);
 	}
 	else
 	{
-		UE_LOG(LogNiagaraTextToolkit, Warning, TEXT("NTT DI: Font '%s' is invalid or not an offline cached font - Characters array will be empty"), *GetNameSafe(FontAsset));
-		return false;
+		FNTTTextLayoutEngine::Layout(*GlyphTable, Settings, Text, *NewLayout);
 	}
+
+	// Packed once here, off the render thread, and shared with every instance that finds the layout in the cache.
+	NewLayout->Packed = FNTTTextBufferRegistry::Pack(*NewLayout, GlyphTable.Get());
+	return NewLayout;
 }
 
-TArray<FVector2f> UNTTDataInterface::GetCharacterPositions(const TArray<FVector2f>& CharacterSpriteSizes, const TArray<int32>& VerticalOffsets, int32 Kerning, float ExtraVerticalOffset, float ExtraKerningOffset, float WhitespaceWidthMultiplier, FString InputString, ENTTTextHorizontalAlignment XAlignment, ENTTTextVerticalAlignment YAlignment, float& OutTotalHeight)
+// Points InstanceData at GlyphTable and Layout, bumping its generation if either changed
+static void SetInstanceContent(FNDIFontUVInfoInstanceData& InstanceData, const FNTTGlyphTablePtr& GlyphTable, FNTTTextLayoutPtr&& Layout)
 {
+	const bool bSameGlyphTable = InstanceData.GlyphTable == GlyphTable;
+	if (!bSameGlyphTable)
+	{
+		InstanceData.GlyphTable = GlyphTable;
+		// Number glyph metrics belong to the previous table, and a number shown with it has to be laid out again.
+		InstanceData.NumberGlyphs.bBuilt = false;
+		InstanceData.NumberText = FNTTNumberText();
+	}
 
-	TArray<FVector2f> CharacterPositionsUnfiltered;
-	OutTotalHeight = 0.0f;
+	if (Layout != InstanceData.Layout || !bSameGlyphTable)
+	{
+		InstanceData.Layout = MoveTemp(Layout);
+		++InstanceData.Generation;
+	}
+}
 
-	const int32 TextLength = InputString.Len();
-	if (TextLength <= 0 || CharacterSpriteSizes.Num() == 0)
+// Drops InstanceData's async layout, telling its task to skip the work if it hasn't started it yet
+static void CancelPendingLayout(FNDIFontUVInfoInstanceData& InstanceData)
+{
+	if (InstanceData.PendingCancelled.IsValid())
 	{
-		return CharacterPositionsUnfiltered;
+		InstanceData.PendingCancelled->store(true, std::memory_order_relaxed);
 	}
+	InstanceData.PendingLayout = UE::Tasks::TTask<FNTTTextLayoutPtr>();
+	InstanceData.PendingGlyphTable.Reset();
+	InstanceData.PendingCancelled.Reset();
+}
 
-	// Initialize to (0,0) so that indices for newline characters
-	// are still valid when later indexed by the text processing passes.
-	CharacterPositionsUnfiltered.Init(FVector2f(0.0f, 0.0f), TextLength);
+void UNTTDataInterface::UpdateContent(FNDIFontUVInfoInstanceData& InstanceData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NTTDataInterface_UpdateContent);
 
-	// Global fallback line height in case a line has no drawable characters.
-	float GlobalMaxGlyphHeight = 0.0f;
-	for (const FVector2f& Size : CharacterSpriteSizes)
+	FString Text;
+	FNTTTextLayoutSettings Settings;
+	const UFont* Font = nullptr;
+	const UNTTFontMetrics* Metrics = nullptr;
+	bool bAsync = false;
 	{
-		GlobalMaxGlyphHeight = FMath::Max(GlobalMaxGlyphHeight, Size.Y);
+		FScopeLock Lock(&ContentLock);
+		InstanceData.ContentSerial = ContentSerial.load(std::memory_order_relaxed);
+		Text = InputText;
+		Settings = GetLayoutSettings();
+		Font = FontAsset;
+		Metrics = FontMetrics;
+		const bool bUseContentLayoutMode = ContentLayoutMode != ENTTLayoutMode::NTT_LM_Default && ContentLayoutModeSerial == InstanceData.ContentSerial;
+		bAsync = bUseContentLayoutMode ? ContentLayoutMode == ENTTLayoutMode::NTT_LM_Async : bAsyncLayout;
 	}
 
-	const float CharIncrement = static_cast<float>(Kerning) + ExtraKerningOffset; // No extra horizontal spacing in this data interface.
-
-	// Per-line widths, heights, and tops
-	// tops are aligned at 0, so the top of the first line is at 0, and the top of the second line is the height of the first line, etc.
-	TArray<float> LineWidths;
-	TArray<float> LineHeights;
-	TArray<float> LineTops;
-	float TotalHeight = 0.0f;
+	// A layout still in flight was for older content
+	CancelPendingLayout(InstanceData);
 
-	FNTTTextIterator It(InputString);
+	// Glyph data is shared across every instance using this font, so only the text is processed here.
+	// It is resolved here even for async layout, as building it reads the font asset.
+	FNTTGlyphTablePtr GlyphTable;
+	if (Metrics)
+	{
+		GlyphTable = Metrics->GetGlyphTable();
+	}
+	else if (!FNTTFontCache::Get().FindOrAdd(Font, GlyphTable))
+	{
+		UE_LOG(LogNiagaraTextToolkit, Warning, TEXT("NTT DI: Failed to get font info from FontAsset '%s'"), *GetNameSafe(Font));
+	}
+	InstanceData.bFilterWhitespaceCharactersValue = Settings.bFilterWhitespaceCharacters;
 
-	while (It.HasNextCharacter())
+	// A number set through SetNumber replaces InputText and is laid out through the numeric path instead of the layout cache.
+	if (NumberSerial.load(std::memory_order_acquire) != 0)
 	{
-		float LineX = 0.0f;
-		float MaxBottom = 0.0f;
+		SetInstanceContent(InstanceData, GlyphTable, CopyTemp(InstanceData.Layout));
+		UpdateNumberLayout(InstanceData);
+		return;
+	}
+	// Forget the number shown before, so setting the same number again switches back to it instead of matching the text's layout.
+	InstanceData.NumberSerial = 0;
+	InstanceData.NumberText = FNTTNumberText();
 
-		int32 SourceIndex = INDEX_NONE;
-		TCHAR Ch = 0;
+	// Identical text with identical settings and font is laid out once and shared by every instance showing it.
+	FNTTTextLayoutCache& LayoutCache = FNTTTextLayoutCache::Get();
+	// Hashed from the snapshot rather than cached on the DI, so it can never disagree with the text and settings laid out below.
+	const uint64 LayoutKey = FNTTTextLayoutCache::MakeKey(GlyphTable, FNTTTextLayoutCache::HashText(Text, Settings));
+	FNTTTextLayoutPtr Layout = LayoutCache.Find(LayoutKey, GlyphTable, Text, Settings);
 
-		while (It.NextCharacterInLine(SourceIndex, Ch))
+	if (!Layout.IsValid())
+	{
+		// Start from a copy of the layout this instance already shows, or else the one a destroyed instance left behind,
+		// as long as it used the same glyph table, and only relayout the lines from the first edit onward.
+		FNTTTextLayoutPtr PreviousLayout = InstanceData.GlyphTable == GlyphTable ? InstanceData.Layout : FNTTTextLayoutPtr();
+		if (!PreviousLayout.IsValid())
 		{
-			const int32 Code = static_cast<int32>(Ch);
-
-			// Skip characters that do not have glyph data. (positions will be set to 0,0)
-			if (!CharacterSpriteSizes.IsValidIndex(Code) || !VerticalOffsets.IsValidIndex(Code))
+			FScopeLock Lock(&RetainedLayoutLock);
+			if (RetainedGlyphTable == GlyphTable)
 			{
-				continue;
+				PreviousLayout = RetainedLayout;
 			}
+		}
 
-			const FVector2f& GlyphSize = CharacterSpriteSizes[Code];
+		if (bAsync)
+		{
+			// The instance keeps showing what it showed until PerInstanceTick swaps the new layout and glyph table in together.
+			// The task only holds shared, immutable data, so it can outlive the instance.
+			TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> Cancelled = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+			InstanceData.PendingGlyphTable = GlyphTable;
+			InstanceData.PendingCancelled = Cancelled;
+			InstanceData.PendingLayout = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[GlyphTable, Settings = MoveTemp(Settings), Text = MoveTemp(Text), PreviousLayout = MoveTemp(PreviousLayout), LayoutKey, Cancelled]()
+				{
+					// Text replaced again before this task ran, as when typing quickly, isn't laid out or cached at all.
+					if (Cancelled->load(std::memory_order_relaxed))
+					{
+						return FNTTTextLayoutPtr();
+					}
 
-			float SizeX = GlyphSize.X;
-			const float SizeY = GlyphSize.Y;
-			const float TopY  = static_cast<float>(VerticalOffsets[Code]); // how far from the line's origin its top is
+					FNTTTextLayoutPtr NewLayout = BuildLayout(GlyphTable, Settings, Text, PreviousLayout);
+					if (!Cancelled->load(std::memory_order_relaxed))
+					{
+						FNTTTextLayoutCache::Get().Add(LayoutKey, GlyphTable, NewLayout);
+					}
+					return NewLayout;
+				});
 
-			if (IsWhitespaceChar(Code))
+			// A new instance has nothing to show yet, so it shows no characters.
+			if (!InstanceData.Layout.IsValid())
 			{
-				SizeX *= WhitespaceWidthMultiplier;
+				TSharedRef<FNTTTextLayout, ESPMode::ThreadSafe> EmptyLayout = FNTTTextLayoutEngine::AllocateLayout();
+				EmptyLayout->Reset();
+				EmptyLayout->Packed = FNTTTextBufferRegistry::Pack(*EmptyLayout);
+				SetInstanceContent(InstanceData, GlyphTable, EmptyLayout);
 			}
+			return;
+		}
 
-			const float BottomY = TopY + SizeY; // how far from the line's origin its bottom is
-			MaxBottom = FMath::Max(MaxBottom, BottomY);
-
-			LineX += SizeX;
+		Layout = BuildLayout(GlyphTable, Settings, Text, PreviousLayout);
+		LayoutCache.Add(LayoutKey, GlyphTable, Layout);
+	}
 
-			// If we have another non-whitespace character on this line, add kerning.
-			TCHAR NextCh = 0;
-			if (It.PeekNextCharacterInLine(NextCh) && !FChar::IsWhitespace(NextCh))
-			{
-				LineX += CharIncrement;
-			}
-		}
+	SetInstanceContent(InstanceData, GlyphTable, MoveTemp(Layout));
+}
 
-		LineWidths.Add(LineX);
+void UNTTDataInterface::FinishPendingLayout(FNDIFontUVInfoInstanceData& InstanceData)
+{
+	FNTTTextLayoutPtr Layout = InstanceData.PendingLayout.GetResult();
+	SetInstanceContent(InstanceData, InstanceData.PendingGlyphTable, MoveTemp(Layout));
+	InstanceData.PendingLayout = UE::Tasks::TTask<FNTTTextLayoutPtr>();
+	InstanceData.PendingGlyphTable.Reset();
+	InstanceData.PendingCancelled.Reset();
+}
 
-		const float LineHeight = (MaxBottom > 0.0f) ? MaxBottom : GlobalMaxGlyphHeight;
-		LineHeights.Add(LineHeight);
-		LineTops.Add(TotalHeight);
-		TotalHeight += LineHeight;
+void UNTTDataInterface::UpdateNumberLayout(FNDIFontUVInfoInstanceData& InstanceData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NTTDataInterface_UpdateNumberLayout);
 
-		if (It.HasNextCharacter())
-		{
-			TotalHeight += ExtraVerticalOffset;
-		}
+	FNTTNumberText Number;
+	{
+		FScopeLock Lock(&NumberLock);
+		Number = NumberText;
+		InstanceData.NumberSerial = NumberSerial.load(std::memory_order_relaxed);
 	}
-	
-	OutTotalHeight = TotalHeight;
 
-	// if there are no lines, return an array of all zeros (in the case where all characters are newlines)
-	const int32 NumLines = LineWidths.Num();
-	if (NumLines == 0)
+	FNTTTextLayoutSettings Settings;
 	{
-		return CharacterPositionsUnfiltered;
+		FScopeLock Lock(&ContentLock);
+		Settings = GetLayoutSettings();
 	}
 
-	// Vertical alignment: decide where the block of text is placed relative to Y=0.
-	float VerticalOffset = 0.0f;
-	switch (YAlignment)
+	// Setting a counter to a value it already shows keeps the current layout, and with it the render thread's text buffer.
+	if (InstanceData.Layout.IsValid() && InstanceData.NumberText == Number && InstanceData.Layout->Settings == Settings)
 	{
-		case ENTTTextVerticalAlignment::NTT_TVA_Top:
-		{
-			// Top of first line at Y=0.
-			VerticalOffset = 0.0f;
-			break;
-		}
-		case ENTTTextVerticalAlignment::NTT_TVA_Center:
-		{
-			// Center of the whole block at Y=0.
-			VerticalOffset = -(TotalHeight * 0.5f);
-			break;
-		}
-		case ENTTTextVerticalAlignment::NTT_TVA_Bottom:
-		{
-			// Bottom of the last line at Y=0.
-			VerticalOffset = -TotalHeight;
-			break;
-		}
-		default:
-		{
-			break;
-		}
+		return;
 	}
 
-	// Horizontal alignment: compute per-line starting X.
-	TArray<float> LineStartX;
-	LineStartX.SetNum(NumLines);
+	// The number replaces any text still being laid out, but picks up the font that text was waiting on.
+	if (InstanceData.PendingLayout.IsValid())
+	{
+		SetInstanceContent(InstanceData, InstanceData.PendingGlyphTable, CopyTemp(InstanceData.Layout));
+		CancelPendingLayout(InstanceData);
+	}
 
-	for (int32 LineIdx = 0; LineIdx < NumLines; ++LineIdx)
+	if (!InstanceData.NumberGlyphs.bBuilt && InstanceData.GlyphTable.IsValid())
 	{
-		const float Width = LineWidths[LineIdx];
-		float StartX = 0.0f;
+		InstanceData.NumberGlyphs.Build(*InstanceData.GlyphTable);
+	}
 
-		switch (XAlignment)
-		{
-			case ENTTTextHorizontalAlignment::NTT_THA_Left:
-			{
-				StartX = 0.0f;
-				break;
-			}
-			case ENTTTextHorizontalAlignment::NTT_THA_Center:
-			{
-				StartX = -Width * 0.5f;
-				break;
-			}
-			case ENTTTextHorizontalAlignment::NTT_THA_Right:
-			{
-				StartX = -Width;
-				break;
-			}
-			default:
-			{
-				break;
-			}
-		}
+	// The layout may still be read by the render thread, so the number goes into a fresh layout from the pool rather than being patched in place.
+	TSharedRef<FNTTTextLayout, ESPMode::ThreadSafe> NewLayout = FNTTTextLayoutEngine::AllocateLayout();
+	FNTTTextLayoutEngine::LayoutNumber(InstanceData.NumberGlyphs, Settings, Number, *NewLayout);
+	NewLayout->Packed = FNTTTextBufferRegistry::Pack(*NewLayout, InstanceData.GlyphTable.Get());
 
-		LineStartX[LineIdx] = StartX;
-	}
+	InstanceData.NumberText = Number;
+	InstanceData.Layout = NewLayout;
+	++InstanceData.Generation;
+}
+
+void UNTTDataInterface::SetNumber(int64 Value, const FNTTNumberFormat& Format)
+{
+	SetNumberText(FNTTNumberText::FromInteger(Value, Format));
+}
 
-	// Second pass: assign a position to each character index in the original string,
-	// walking the text again line-by-line using the iterator.
-	FNTTTextIterator It2(InputString);
+void UNTTDataInterface::SetFloatNumber(double Value, const FNTTNumberFormat& Format)
+{
+	SetNumberText(FNTTNumberText::FromFloat(Value, Format));
+}
 
-	for (int32 LineIdx = 0; LineIdx < NumLines && It2.HasNextCharacter(); ++LineIdx)
-	{
-		float LineX = 0.0f;
-		const float LineTop = LineTops[LineIdx] + VerticalOffset;
+void UNTTDataInterface::SetNumberText(const FNTTNumberText& Number)
+{
+	FScopeLock Lock(&NumberLock);
+	NumberText = Number;
 
-		int32 SourceIndex = INDEX_NONE;
-		TCHAR Ch = 0;
+	// Skip 0 on wrap-around, it means numeric mode is off.
+	const uint32 NextSerial = NumberSerial.load(std::memory_order_relaxed) + 1;
+	NumberSerial.store(NextSerial != 0 ? NextSerial : 1, std::memory_order_release);
+}
 
-		while (It2.NextCharacterInLine(SourceIndex, Ch))
-		{
-			const int32 Code = static_cast<int32>(Ch);
+void UNTTDataInterface::ClearNumber()
+{
+	{
+		FScopeLock Lock(&NumberLock);
+		NumberSerial.store(0, std::memory_order_release);
+	}
+	// Instances only look at the number while it is set, so they are sent back to InputText through the content serial.
+	InvalidateContent();
+}
 
-			// Skip characters that do not have glyph data. (positions will be set to 0,0)
-			if (!CharacterSpriteSizes.IsValidIndex(Code) || !VerticalOffsets.IsValidIndex(Code))
-			{
-				continue;
-			}
+void UNTTDataInterface::InvalidateContent()
+{
+	FScopeLock Lock(&ContentLock);
+	ContentSerial.fetch_add(1, std::memory_order_release);
+}
 
-			const FVector2f& GlyphSize = CharacterSpriteSizes[Code];
+template<typename T>
+void UNTTDataInterface::SetContentProperty(T& Property, const T& Value)
+{
+	{
+		FScopeLock Lock(&ContentLock);
+		Property = Value;
+	}
+	InvalidateContent();
+}
 
-			float SizeX = GlyphSize.X;
-			const float SizeY = GlyphSize.Y;
-			const float TopY  = static_cast<float>(VerticalOffsets[Code]);
+void UNTTDataInterface::SetText(const FString& Text, ENTTLayoutMode LayoutMode)
+{
+	ClearNumber();
 
-			if (IsWhitespaceChar(Code))
-			{
-				SizeX *= WhitespaceWidthMultiplier;
-			}
+	// The layout mode only applies to the serial bumped here, so a later change to any other property uses Async Layout again.
+	FScopeLock Lock(&ContentLock);
+	InputText = Text;
+	ContentLayoutMode = LayoutMode;
+	ContentLayoutModeSerial = ContentSerial.fetch_add(1, std::memory_order_release) + 1;
+}
 
-			const float GlyphLeft = LineStartX[LineIdx] + LineX;
-			const float GlyphTop  = LineTop + TopY;
+void UNTTDataInterface::SetPath(TArray<FVector2D>&& Points, ENTTTextPathMode Mode)
+{
+	{
+		FScopeLock Lock(&ContentLock);
+		PathPoints = MoveTemp(Points);
+		PathMode = Mode;
+	}
+	InvalidateContent();
+}
 
-			const float PosX = GlyphLeft + SizeX * 0.5f;
-			const float PosY = GlyphTop + SizeY * 0.5f;
+void UNTTDataInterface::SetFont(UFont* Font)
+{
+	SetContentProperty(FontAsset, Font);
+}
 
-			CharacterPositionsUnfiltered[SourceIndex] = FVector2f(PosX, PosY);
+void UNTTDataInterface::SetFontMetrics(UNTTFontMetrics* InFontMetrics)
+{
+	SetContentProperty(FontMetrics, InFontMetrics);
+}
 
-			LineX += SizeX;
+void UNTTDataInterface::SetInputText(const FString& Text)
+{
+	SetText(Text);
+}
 
-			// Apply kerning based on the next character in this logical line, if any.
-			TCHAR NextCh = 0;
-			if (It2.PeekNextCharacterInLine(NextCh) && !FChar::IsWhitespace(NextCh))
-			{
-				LineX += CharIncrement;
-			}
-		}
-	}
+void UNTTDataInterface::SetHorizontalAlignment(ENTTTextHorizontalAlignment Alignment)
+{
+	SetContentProperty(HorizontalAlignment, Alignment);
+}
 
-	return CharacterPositionsUnfiltered;
+void UNTTDataInterface::SetVerticalAlignment(ENTTTextVerticalAlignment Alignment)
+{
+	SetContentProperty(VerticalAlignment, Alignment);
 }
 
-void UNTTDataInterface::ProcessText(
-	const FString& InputText,
-	const TArray<FVector2f>& CharacterPositionsUnfiltered,
-	const bool bFilterWhitespace,
-	TArray<int32>& OutUnicode,
-	TArray<FVector2f>& OutCharacterPositions,
-	TArray<int32>& OutLineStartIndices,
-	TArray<int32>& OutLineCharacterCounts,
-	TArray<int32>& OutWordStartIndices,
-	TArray<int32>& OutWordCharacterCounts)
+void UNTTDataInterface::SetVerticalOffset(float Offset)
 {
-	OutUnicode.Reset();
-	OutCharacterPositions.Reset();
-	OutLineStartIndices.Reset();
-	OutWordStartIndices.Reset();
-	OutWordCharacterCounts.Reset();
+	SetContentProperty(VerticalOffset, Offset);
+}
 
-	// First line always starts at index 0.
-	OutLineStartIndices.Add(0);
+void UNTTDataInterface::SetKerningOffset(float Offset)
+{
+	SetContentProperty(KerningOffset, Offset);
+}
 
-	OutUnicode.Reserve(InputText.Len());
-	OutCharacterPositions.Reserve(InputText.Len());
+void UNTTDataInterface::SetWhitespaceWidthMultiplier(float Multiplier)
+{
+	SetContentProperty(WhitespaceWidthMultiplier, Multiplier);
+}
 
-	FNTTTextIterator It(InputText);
+void UNTTDataInterface::SetFilterWhitespaceCharacters(bool bFilter)
+{
+	SetContentProperty(bFilterWhitespaceCharacters, bFilter);
+}
 
-	bool bInsideWord = false;
-	int32 CurrentWordStartIndex = -1;
-	int32 CurrentWordCharCount = 0;
+void UNTTDataInterface::SetMaxLineWidth(float Width)
+{
+	SetContentProperty(MaxLineWidth, FMath::Max(Width, 0.0f));
+}
 
-	while (It.HasNextCharacter())
-	{
-		int32 SourceIndex = INDEX_NONE;
-		TCHAR Ch = 0;
+void UNTTDataInterface::SetParseMarkup(bool bParse)
+{
+	SetContentProperty(bParseMarkup, bParse);
+}
 
-		while (It.NextCharacterInLine(SourceIndex, Ch))
-		{
-			const int32 Code = static_cast<int32>(Ch);
-			const bool bIsWhitespace = IsWhitespaceChar(Code);
+void UNTTDataInterface::SetMarkupStyles(const TArray<FName>& Styles)
+{
+	SetContentProperty(MarkupStyles, Styles);
+}
 
-			// Handle word state transitions
-			if (bIsWhitespace)
-			{
-				if (bInsideWord)
-				{
-					bInsideWord = false;
-					OutWordStartIndices.Add(CurrentWordStartIndex);
-					OutWordCharacterCounts.Add(CurrentWordCharCount);
-				}
-			}
-			else
-			{
-				if (!bInsideWord)
-				{
-					bInsideWord = true;
-					CurrentWordStartIndex = OutUnicode.Num();
-					CurrentWordCharCount = 0;
-				}
-				CurrentWordCharCount++;
-			}
+void UNTTDataInterface::SetPathMode(ENTTTextPathMode Mode)
+{
+	SetContentProperty(PathMode, Mode);
+}
 
-			// Filter logic: if filtering is on and it's whitespace, skip output.
-			if (bFilterWhitespace && bIsWhitespace)
-			{
-				continue;
-			}
+void UNTTDataInterface::SetArcRadius(float Radius)
+{
+	SetContentProperty(ArcRadius, Radius);
+}
 
-			// Add to output
-			OutUnicode.Add(Code);
-			OutCharacterPositions.Add(CharacterPositionsUnfiltered[SourceIndex]);
-		}
+void UNTTDataInterface::SetArcStartAngle(float Angle)
+{
+	SetContentProperty(ArcStartAngle, Angle);
+}
 
-		// End of logical line. Check if there is another line following (meaning we consumed a newline).
-		if (It.HasNextCharacter())
-		{
-			// Newline breaks word in both modes.
-			if (bInsideWord)
-			{
-				bInsideWord = false;
-				OutWordStartIndices.Add(CurrentWordStartIndex);
-				OutWordCharacterCounts.Add(CurrentWordCharCount);
-			}
+void UNTTDataInterface::SetPathPoints(const TArray<FVector2D>& Points)
+{
+	SetContentProperty(PathPoints, Points);
+}
 
-			// Mark the start of the next line
-			OutLineStartIndices.Add(OutUnicode.Num());
-		}
-	}
+void UNTTDataInterface::SetAsyncLayout(bool bAsync)
+{
+	SetContentProperty(bAsyncLayout, bAsync);
+}
 
-	if (bInsideWord)
+FNTTTextLayoutSettings UNTTDataInterface::GetLayoutSettings() const
+{
+	FNTTTextLayoutSettings Settings;
+	Settings.HorizontalAlignment = HorizontalAlignment;
+	Settings.VerticalAlignment = VerticalAlignment;
+	Settings.VerticalOffset = VerticalOffset;
+	Settings.KerningOffset = KerningOffset;
+	Settings.WhitespaceWidthMultiplier = WhitespaceWidthMultiplier;
+	Settings.bFilterWhitespaceCharacters = bFilterWhitespaceCharacters;
+	Settings.MaxLineWidth = MaxLineWidth;
+	Settings.bParseMarkup = bParseMarkup;
+	if (bParseMarkup)
 	{
-		OutWordStartIndices.Add(CurrentWordStartIndex);
-		OutWordCharacterCounts.Add(CurrentWordCharCount);
+		Settings.MarkupStyles = MarkupStyles;
 	}
-
-	// Derive per-line character counts from the line start indices.
-	OutLineCharacterCounts.Reset();
-	OutLineCharacterCounts.Reserve(OutLineStartIndices.Num());
-	for (int32 LineIdx = 0; LineIdx < OutLineStartIndices.Num(); ++LineIdx)
+	Settings.PathMode = PathMode;
+	if (PathMode == ENTTTextPathMode::NTT_TPM_Arc)
 	{
-		if (LineIdx < OutLineStartIndices.Num() - 1)
-		{
-			OutLineCharacterCounts.Add(OutLineStartIndices[LineIdx + 1] - OutLineStartIndices[LineIdx]);
-		}
-		else
+		Settings.ArcRadius = ArcRadius;
+		Settings.ArcStartAngle = ArcStartAngle;
+	}
+	else if (PathMode == ENTTTextPathMode::NTT_TPM_Path)
+	{
+		Settings.PathPoints.Reserve(PathPoints.Num());
+		for (const FVector2D& Point : PathPoints)
 		{
-			OutLineCharacterCounts.Add(OutUnicode.Num() - OutLineStartIndices[LineIdx]);
+			Settings.PathPoints.Add(FVector2f(Point));
 		}
 	}
+	return Settings;
+}
+
+#if WITH_EDITOR
+void UNTTDataInterface::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateContent();
 }
+#endif
 
 // Clean up RT instances
 void UNTTDataInterface::DestroyPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance)
 {
 	FNDIFontUVInfoInstanceData* InstanceData = static_cast<FNDIFontUVInfoInstanceData*>(PerInstanceData);
+	CancelPendingLayout(*InstanceData);
+	{
+		FScopeLock Lock(&RetainedLayoutLock);
+		RetainedLayout = MoveTemp(InstanceData->Layout);
+		RetainedGlyphTable = InstanceData->GlyphTable;
+	}
 	InstanceData->~FNDIFontUVInfoInstanceData();
 
 	ENQUEUE_RENDER_COMMAND(RemoveProxy)
@@ -772,6 +707,185 @@ void UNTTDataInterface::GetFunctions(TArray<FNiagaraFunctionSignature>& OutFunct
 	SigTextHeight.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
 	SigTextHeight.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("TextHeight")));
 	OutFunctions.Add(SigTextHeight);
+
+	// Register GetCharacterPage
+	FNiagaraFunctionSignature SigCharacterPage;
+	SigCharacterPage.Name = GetCharacterPageName;
+#if WITH_EDITORONLY_DATA
+	SigCharacterPage.Description = LOCTEXT("GetCharacterPageDesc", "Returns the index of the font texture page the glyph for the given character index is stored on. The UVs returned by GetCharacterUV are relative to this page.");
+#endif
+	SigCharacterPage.bMemberFunction = true;
+	SigCharacterPage.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigCharacterPage.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CharacterIndex")));
+	SigCharacterPage.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Page")));
+	OutFunctions.Add(SigCharacterPage);
+
+	// Register GetCharacterColor
+	FNiagaraFunctionSignature SigCharacterColor;
+	SigCharacterColor.Name = GetCharacterColorName;
+#if WITH_EDITORONLY_DATA
+	SigCharacterColor.Description = LOCTEXT("GetCharacterColorDesc", "Returns the linear color set by <c=#RRGGBB> markup for the given character index. White when Parse Markup is off or the character has no color tag.");
+#endif
+	SigCharacterColor.bMemberFunction = true;
+	SigCharacterColor.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigCharacterColor.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CharacterIndex")));
+	SigCharacterColor.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetColorDef(), TEXT("Color")));
+	OutFunctions.Add(SigCharacterColor);
+
+	// Register GetCharacterScale
+	FNiagaraFunctionSignature SigCharacterScale;
+	SigCharacterScale.Name = GetCharacterScaleName;
+#if WITH_EDITORONLY_DATA
+	SigCharacterScale.Description = LOCTEXT("GetCharacterScaleDesc", "Returns the scale set by <s=Scale> markup for the given character index, 1 without one. Positions already include it; multiply the sprite size by it to draw the glyph at its scaled size.");
+#endif
+	SigCharacterScale.bMemberFunction = true;
+	SigCharacterScale.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigCharacterScale.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CharacterIndex")));
+	SigCharacterScale.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Scale")));
+	OutFunctions.Add(SigCharacterScale);
+
+	// Register GetCharacterStyle
+	FNiagaraFunctionSignature SigCharacterStyle;
+	SigCharacterStyle.Name = GetCharacterStyleName;
+#if WITH_EDITORONLY_DATA
+	SigCharacterStyle.Description = LOCTEXT("GetCharacterStyleDesc", "Returns the index into Markup Styles set by <style=Name> markup for the given character index, or -1 without a known style.");
+#endif
+	SigCharacterStyle.bMemberFunction = true;
+	SigCharacterStyle.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigCharacterStyle.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CharacterIndex")));
+	SigCharacterStyle.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Style")));
+	OutFunctions.Add(SigCharacterStyle);
+
+	// Register GetCharacterLineIndex
+	FNiagaraFunctionSignature SigCharacterLineIndex;
+	SigCharacterLineIndex.Name = GetCharacterLineIndexName;
+#if WITH_EDITORONLY_DATA
+	SigCharacterLineIndex.Description = LOCTEXT("GetCharacterLineIndexDesc", "Returns the index of the line containing the given character index, and the character's index within that line.");
+#endif
+	SigCharacterLineIndex.bMemberFunction = true;
+	SigCharacterLineIndex.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigCharacterLineIndex.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CharacterIndex")));
+	SigCharacterLineIndex.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("LineIndex")));
+	SigCharacterLineIndex.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("IndexInLine")));
+	OutFunctions.Add(SigCharacterLineIndex);
+
+	// Register GetCharacterWordIndex
+	FNiagaraFunctionSignature SigCharacterWordIndex;
+	SigCharacterWordIndex.Name = GetCharacterWordIndexName;
+#if WITH_EDITORONLY_DATA
+	SigCharacterWordIndex.Description = LOCTEXT("GetCharacterWordIndexDesc", "Returns the index of the word containing the given character index, and the character's index within that word. Whitespace after a word counts as part of it. Both are -1 for characters before the first word.");
+#endif
+	SigCharacterWordIndex.bMemberFunction = true;
+	SigCharacterWordIndex.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigCharacterWordIndex.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CharacterIndex")));
+	SigCharacterWordIndex.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("WordIndex")));
+	SigCharacterWordIndex.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("IndexInWord")));
+	OutFunctions.Add(SigCharacterWordIndex);
+
+	// Register GetCharacterTransform
+	FNiagaraFunctionSignature SigCharacterTransform;
+	SigCharacterTransform.Name = GetCharacterTransformName;
+#if WITH_EDITORONLY_DATA
+	SigCharacterTransform.Description = LOCTEXT("GetCharacterTransformDesc", "Returns the position and rotation of the given character index. When Path Mode bends the text, both are baked at layout time: Rotation turns the character about the text's forward (X) axis to follow the curve, and Angle is the same rotation in degrees for sprites.");
+#endif
+	SigCharacterTransform.bMemberFunction = true;
+	SigCharacterTransform.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigCharacterTransform.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CharacterIndex")));
+	SigCharacterTransform.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetPositionDef(), TEXT("CharacterPosition")));
+	SigCharacterTransform.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetQuatDef(), TEXT("Rotation")));
+	SigCharacterTransform.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Angle")));
+	OutFunctions.Add(SigCharacterTransform);
+
+	// Register GetLineWidth
+	FNiagaraFunctionSignature SigLineWidth;
+	SigLineWidth.Name = GetLineWidthName;
+#if WITH_EDITORONLY_DATA
+	SigLineWidth.Description = LOCTEXT("GetLineWidthDesc", "Returns the width in pixels of the given line index, from its first glyph's left edge to its last glyph's right edge.");
+#endif
+	SigLineWidth.bMemberFunction = true;
+	SigLineWidth.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigLineWidth.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("LineIndex")));
+	SigLineWidth.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("LineWidth")));
+	OutFunctions.Add(SigLineWidth);
+
+	// Register GetLineTop
+	FNiagaraFunctionSignature SigLineTop;
+	SigLineTop.Name = GetLineTopName;
+#if WITH_EDITORONLY_DATA
+	SigLineTop.Description = LOCTEXT("GetLineTopDesc", "Returns the Z of the top edge of the given line index, in the same space as GetCharacterPosition, and the line's height in pixels.");
+#endif
+	SigLineTop.bMemberFunction = true;
+	SigLineTop.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigLineTop.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("LineIndex")));
+	SigLineTop.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("LineTop")));
+	SigLineTop.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("LineHeight")));
+	OutFunctions.Add(SigLineTop);
+
+	// Register GetWordBounds
+	FNiagaraFunctionSignature SigWordBounds;
+	SigWordBounds.Name = GetWordBoundsName;
+#if WITH_EDITORONLY_DATA
+	SigWordBounds.Description = LOCTEXT("GetWordBoundsDesc", "Returns the (Y, Z) corners of the box around the glyphs of the given word index, in the same space as GetCharacterPosition. Both are 0 for a word with no drawn glyphs.");
+#endif
+	SigWordBounds.bMemberFunction = true;
+	SigWordBounds.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigWordBounds.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("WordIndex")));
+	SigWordBounds.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetVec2Def(), TEXT("BoundsMin")));
+	SigWordBounds.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetVec2Def(), TEXT("BoundsMax")));
+	OutFunctions.Add(SigWordBounds);
+
+	// Register GetTextBounds
+	FNiagaraFunctionSignature SigTextBounds;
+	SigTextBounds.Name = GetTextBoundsName;
+#if WITH_EDITORONLY_DATA
+	SigTextBounds.Description = LOCTEXT("GetTextBoundsDesc", "Returns the (Y, Z) corners of the box around every word's glyphs, in the same space as GetCharacterPosition. Both are 0 for empty text.");
+#endif
+	SigTextBounds.bMemberFunction = true;
+	SigTextBounds.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigTextBounds.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetVec2Def(), TEXT("BoundsMin")));
+	SigTextBounds.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetVec2Def(), TEXT("BoundsMax")));
+	OutFunctions.Add(SigTextBounds);
+
+	// Register GetTextGeneration
+	FNiagaraFunctionSignature SigTextGeneration;
+	SigTextGeneration.Name = GetTextGenerationName;
+#if WITH_EDITORONLY_DATA
+	SigTextGeneration.Description = LOCTEXT("GetTextGenerationDesc", "Returns a number that changes every time the text, font or layout of this instance changes without the system being reinitialized. Store it on spawn and compare it to respawn or refresh particles only when the text changed.");
+#endif
+	SigTextGeneration.bMemberFunction = true;
+	SigTextGeneration.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigTextGeneration.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("Generation")));
+	OutFunctions.Add(SigTextGeneration);
+
+	// Register GetCharacterRecord
+	FNiagaraFunctionSignature SigCharacterRecord;
+	SigCharacterRecord.Name = GetCharacterRecordName;
+#if WITH_EDITORONLY_DATA
+	SigCharacterRecord.Description = LOCTEXT("GetCharacterRecordDesc", "Returns everything a spawn module usually needs for the given character index at once: the same values as GetCharacterPosition, GetCharacterSpriteSize, GetCharacterUV, GetCharacterLineIndex and GetCharacterWordIndex. On the GPU this is two loads per character.");
+#endif
+	SigCharacterRecord.bMemberFunction = true;
+	SigCharacterRecord.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigCharacterRecord.AddInput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("CharacterIndex")));
+	SigCharacterRecord.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetPositionDef(), TEXT("CharacterPosition")));
+	SigCharacterRecord.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetVec2Def(), TEXT("SpriteSize")));
+	SigCharacterRecord.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("USize")));
+	SigCharacterRecord.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("VSize")));
+	SigCharacterRecord.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("UStart")));
+	SigCharacterRecord.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("VStart")));
+	SigCharacterRecord.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("LineIndex")));
+	SigCharacterRecord.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetIntDef(), TEXT("WordIndex")));
+	OutFunctions.Add(SigCharacterRecord);
+
+	// Register IsTextReady
+	FNiagaraFunctionSignature SigTextReady;
+	SigTextReady.Name = IsTextReadyName;
+#if WITH_EDITORONLY_DATA
+	SigTextReady.Description = LOCTEXT("IsTextReadyDesc", "Returns false while the instance's text is being laid out asynchronously. Until then it shows its previous text, or no characters if it has none. GetTextGeneration changes when the new text is swapped in.");
+#endif
+	SigTextReady.bMemberFunction = true;
+	SigTextReady.AddInput(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Font UV Information interface")));
+	SigTextReady.AddOutput(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("IsReady")));
+	OutFunctions.Add(SigTextReady);
 }
 
 void UNTTDataInterface::BuildShaderParameters(FNiagaraShaderParametersBuilder& ShaderParametersBuilder) const
@@ -788,45 +902,91 @@ void UNTTDataInterface::SetShaderParameters(const FNiagaraDataInterfaceSetShader
 	DataInterfaceProxy.EnsureDefaultBuffer(RHICmdList);
 
 	FShaderParameters* ShaderParameters = Context.GetParameterNestedStruct<FShaderParameters>();
-	if (RTData && RTData->PackedBuffer.SRV.IsValid())
+	if (RTData && RTData->TextBufferSRV.IsValid())
 	{
-		ShaderParameters->PackedBuffer = RTData->PackedBuffer.SRV;
+		ShaderParameters->GlyphBuffer = RTData->GlyphBufferSRV.IsValid() ? RTData->GlyphBufferSRV : DataInterfaceProxy.PackedBuffer.SRV;
+		ShaderParameters->PackedBuffer = RTData->TextBufferSRV;
+		ShaderParameters->CharacterRecords = RTData->CharacterRecordSRV.IsValid() ? RTData->CharacterRecordSRV : DataInterfaceProxy.DefaultRecordBuffer.SRV;
 		
 		ShaderParameters->Offset_UVs = RTData->Offset_UVs;
 		ShaderParameters->Offset_Sizes = RTData->Offset_Sizes;
-		ShaderParameters->Offset_Unicode = RTData->Offset_Unicode;
+		ShaderParameters->Offset_Pages = RTData->Offset_Pages;
+		ShaderParameters->Offset_GlyphIndices = RTData->Offset_GlyphIndices;
 		ShaderParameters->Offset_Positions = RTData->Offset_Positions;
 		ShaderParameters->Offset_LineStart = RTData->Offset_LineStart;
 		ShaderParameters->Offset_LineCount = RTData->Offset_LineCount;
 		ShaderParameters->Offset_WordStart = RTData->Offset_WordStart;
 		ShaderParameters->Offset_WordCount = RTData->Offset_WordCount;
+		ShaderParameters->Offset_CharacterLines = RTData->Offset_CharacterLines;
+		ShaderParameters->Offset_CharacterWords = RTData->Offset_CharacterWords;
+		ShaderParameters->Offset_LinePrefixSums = RTData->Offset_LinePrefixSums;
+		ShaderParameters->Offset_WordPrefixSums = RTData->Offset_WordPrefixSums;
+		ShaderParameters->Offset_WordPrefixSumsWithWhitespace = RTData->Offset_WordPrefixSumsWithWhitespace;
+		ShaderParameters->Offset_Colors = RTData->Offset_Colors;
+		ShaderParameters->Offset_Scales = RTData->Offset_Scales;
+		ShaderParameters->Offset_Styles = RTData->Offset_Styles;
+		ShaderParameters->Offset_Rotations = RTData->Offset_Rotations;
+		ShaderParameters->Offset_LineWidths = RTData->Offset_LineWidths;
+		ShaderParameters->Offset_LineTops = RTData->Offset_LineTops;
+		ShaderParameters->Offset_LineHeights = RTData->Offset_LineHeights;
+		ShaderParameters->Offset_WordBounds = RTData->Offset_WordBounds;
 
 		ShaderParameters->NumRects = RTData->NumRects;
 		ShaderParameters->NumChars = RTData->NumChars;
 		ShaderParameters->NumLines = RTData->NumLines;
 		ShaderParameters->NumWords = RTData->NumWords;
 		ShaderParameters->bFilterWhitespaceCharactersValue = RTData->bFilterWhitespaceCharactersValue;
+		ShaderParameters->bHasMarkup = RTData->bHasMarkup;
+		ShaderParameters->bHasRotations = RTData->bHasRotations;
+		ShaderParameters->bHasCharacterRecords = RTData->bHasCharacterRecords;
+		ShaderParameters->TextBufferFlags = RTData->TextBufferFlags;
+		ShaderParameters->Generation = RTData->Generation;
+		ShaderParameters->bTextReady = RTData->bTextReady;
 		ShaderParameters->TotalTextHeight = RTData->TotalTextHeight;
+		ShaderParameters->TextBounds = RTData->TextBounds;
 	}
 	else
 	{
+		ShaderParameters->GlyphBuffer = DataInterfaceProxy.PackedBuffer.SRV;
 		ShaderParameters->PackedBuffer = DataInterfaceProxy.PackedBuffer.SRV;
+		ShaderParameters->CharacterRecords = DataInterfaceProxy.DefaultRecordBuffer.SRV;
 		
 		ShaderParameters->Offset_UVs = 0;
 		ShaderParameters->Offset_Sizes = 0;
-		ShaderParameters->Offset_Unicode = 0;
+		ShaderParameters->Offset_Pages = 0;
+		ShaderParameters->Offset_GlyphIndices = 0;
 		ShaderParameters->Offset_Positions = 0;
 		ShaderParameters->Offset_LineStart = 0;
 		ShaderParameters->Offset_LineCount = 0;
 		ShaderParameters->Offset_WordStart = 0;
 		ShaderParameters->Offset_WordCount = 0;
+		ShaderParameters->Offset_CharacterLines = 0;
+		ShaderParameters->Offset_CharacterWords = 0;
+		ShaderParameters->Offset_LinePrefixSums = 0;
+		ShaderParameters->Offset_WordPrefixSums = 0;
+		ShaderParameters->Offset_WordPrefixSumsWithWhitespace = 0;
+		ShaderParameters->Offset_Colors = 0;
+		ShaderParameters->Offset_Scales = 0;
+		ShaderParameters->Offset_Styles = 0;
+		ShaderParameters->Offset_Rotations = 0;
+		ShaderParameters->Offset_LineWidths = 0;
+		ShaderParameters->Offset_LineTops = 0;
+		ShaderParameters->Offset_LineHeights = 0;
+		ShaderParameters->Offset_WordBounds = 0;
 
 		ShaderParameters->NumRects = 0;
 		ShaderParameters->NumChars = 0;
 		ShaderParameters->NumLines = 0;
 		ShaderParameters->NumWords = 0;
 		ShaderParameters->bFilterWhitespaceCharactersValue = bFilterWhitespaceCharacters ? 1u : 0u;
+		ShaderParameters->bHasMarkup = 0;
+		ShaderParameters->bHasRotations = 0;
+		ShaderParameters->bHasCharacterRecords = 0;
+		ShaderParameters->TextBufferFlags = 0;
+		ShaderParameters->Generation = RTData ? RTData->Generation : 0u;
+		ShaderParameters->bTextReady = RTData ? RTData->bTextReady : 1u;
 		ShaderParameters->TotalTextHeight = 0.0f;
+		ShaderParameters->TextBounds = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
 	}
 }
 
@@ -835,14 +995,36 @@ bool UNTTDataInterface::CopyToInternal(UNiagaraDataInterface* Destination) const
 	UNTTDataInterface* DestTyped = Cast<UNTTDataInterface>(Destination);
 	if (DestTyped)
 	{
-		DestTyped->FontAsset = FontAsset;
-		DestTyped->InputText = InputText;
-		DestTyped->HorizontalAlignment = HorizontalAlignment;
-		DestTyped->VerticalAlignment = VerticalAlignment;
-		DestTyped->VerticalOffset = VerticalOffset;
-		DestTyped->KerningOffset = KerningOffset;
-		DestTyped->WhitespaceWidthMultiplier = WhitespaceWidthMultiplier;
-		DestTyped->bFilterWhitespaceCharacters = bFilterWhitespaceCharacters;
+		{
+			// The destination may already have instances reading its properties on worker threads.
+			FScopeLock DestLock(&DestTyped->ContentLock);
+			DestTyped->FontAsset = FontAsset;
+			DestTyped->FontMetrics = FontMetrics;
+			DestTyped->InputText = InputText;
+			DestTyped->HorizontalAlignment = HorizontalAlignment;
+			DestTyped->VerticalAlignment = VerticalAlignment;
+			DestTyped->VerticalOffset = VerticalOffset;
+			DestTyped->KerningOffset = KerningOffset;
+			DestTyped->WhitespaceWidthMultiplier = WhitespaceWidthMultiplier;
+			DestTyped->bFilterWhitespaceCharacters = bFilterWhitespaceCharacters;
+			DestTyped->MaxLineWidth = MaxLineWidth;
+			DestTyped->bParseMarkup = bParseMarkup;
+			DestTyped->MarkupStyles = MarkupStyles;
+			DestTyped->PathMode = PathMode;
+			DestTyped->ArcRadius = ArcRadius;
+			DestTyped->ArcStartAngle = ArcStartAngle;
+			DestTyped->PathPoints = PathPoints;
+			DestTyped->bAsyncLayout = bAsyncLayout;
+		}
+		DestTyped->InvalidateContent();
+		{
+			FScopeLock Lock(&NumberLock);
+			DestTyped->SetNumberText(NumberText);
+			if (NumberSerial.load(std::memory_order_relaxed) == 0)
+			{
+				DestTyped->ClearNumber();
+			}
+		}
 		return true;
 	}
 	else
@@ -857,13 +1039,22 @@ bool UNTTDataInterface::Equals(const UNiagaraDataInterface* Other) const
 	const UNTTDataInterface* OtherTyped = Cast<UNTTDataInterface>(Other);
 	const bool bEqual = OtherTyped
 		&& OtherTyped->FontAsset == FontAsset
+		&& OtherTyped->FontMetrics == FontMetrics
 		&& OtherTyped->InputText == InputText
 		&& OtherTyped->HorizontalAlignment == HorizontalAlignment
 		&& OtherTyped->VerticalAlignment == VerticalAlignment
 		&& OtherTyped->VerticalOffset == VerticalOffset
 		&& OtherTyped->KerningOffset == KerningOffset
 		&& OtherTyped->WhitespaceWidthMultiplier == WhitespaceWidthMultiplier
-		&& OtherTyped->bFilterWhitespaceCharacters == bFilterWhitespaceCharacters;
+		&& OtherTyped->bFilterWhitespaceCharacters == bFilterWhitespaceCharacters
+		&& OtherTyped->MaxLineWidth == MaxLineWidth
+		&& OtherTyped->bParseMarkup == bParseMarkup
+		&& OtherTyped->MarkupStyles == MarkupStyles
+		&& OtherTyped->PathMode == PathMode
+		&& OtherTyped->ArcRadius == ArcRadius
+		&& OtherTyped->ArcStartAngle == ArcStartAngle
+		&& OtherTyped->PathPoints == PathPoints
+		&& OtherTyped->bAsyncLayout == bAsyncLayout;
 		UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT DI: Equals - ThisAsset=%s OtherAsset=%s Result=%s"),
 		*GetNameSafe(FontAsset),
 		OtherTyped ? *GetNameSafe(OtherTyped->FontAsset) : TEXT("nullptr"),
@@ -938,6 +1129,62 @@ void UNTTDataInterface::GetVMExternalFunction(const FVMExternalFunctionBindingIn
 	{
 		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetTextHeightVM(Context); });
 	}
+	else if (BindingInfo.Name == GetCharacterPageName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetCharacterPageVM(Context); });
+	}
+	else if (BindingInfo.Name == GetCharacterColorName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetCharacterColorVM(Context); });
+	}
+	else if (BindingInfo.Name == GetCharacterScaleName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetCharacterScaleVM(Context); });
+	}
+	else if (BindingInfo.Name == GetCharacterStyleName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetCharacterStyleVM(Context); });
+	}
+	else if (BindingInfo.Name == GetCharacterLineIndexName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetCharacterLineIndexVM(Context); });
+	}
+	else if (BindingInfo.Name == GetCharacterWordIndexName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetCharacterWordIndexVM(Context); });
+	}
+	else if (BindingInfo.Name == GetCharacterTransformName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetCharacterTransformVM(Context); });
+	}
+	else if (BindingInfo.Name == GetLineWidthName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetLineWidthVM(Context); });
+	}
+	else if (BindingInfo.Name == GetLineTopName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetLineTopVM(Context); });
+	}
+	else if (BindingInfo.Name == GetWordBoundsName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetWordBoundsVM(Context); });
+	}
+	else if (BindingInfo.Name == GetTextBoundsName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetTextBoundsVM(Context); });
+	}
+	else if (BindingInfo.Name == GetTextGenerationName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetTextGenerationVM(Context); });
+	}
+	else if (BindingInfo.Name == GetCharacterRecordName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->GetCharacterRecordVM(Context); });
+	}
+	else if (BindingInfo.Name == IsTextReadyName)
+	{
+		OutFunc = FVMExternalFunction::CreateLambda([this](FVectorVMExternalFunctionContext& Context) { this->IsTextReadyVM(Context); });
+	}
 	else
 	{
 		UE_LOG(LogNiagaraTextToolkit, Display, TEXT("Could not find data interface external function in %s. Received Name: %s"), *GetPathNameSafe(this), *BindingInfo.Name.ToString());
@@ -955,10 +1202,10 @@ void UNTTDataInterface::GetCharacterUVVM(FVectorVMExternalFunctionContext& Conte
 	FNDIOutputParam<float> OutUStart(Context);
 	FNDIOutputParam<float> OutVStart(Context);
 
-	const TArray<int32>& Unicode = InstData.Get()->Unicode;
-	const TArray<FVector4>& TextureUvs = InstData.Get()->CharacterTextureUvs;
+	const TArray<int32>& GlyphIndices = InstData.Get()->Layout->GlyphIndices;
+	const TArray<FVector4f>& TextureUvs = InstData.Get()->GlyphTable->CharacterTextureUvs;
 	const int32 NumRects = TextureUvs.Num();
-	const int32 NumChars = Unicode.Num();
+	const int32 NumChars = GlyphIndices.Num();
 
 	// Iterate over the particles
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
@@ -970,12 +1217,12 @@ void UNTTDataInterface::GetCharacterUVVM(FVectorVMExternalFunctionContext& Conte
 			CharacterIndex = CharacterIndex % NumChars;
 		}
 
-		const int32 UnicodeIndex = (Unicode.IsValidIndex(CharacterIndex)) ? Unicode[CharacterIndex] : -1;
+		const int32 GlyphIndex = (GlyphIndices.IsValidIndex(CharacterIndex)) ? GlyphIndices[CharacterIndex] : -1;
 
 		// Bounds check
-		if (NumRects > 0 && UnicodeIndex >= 0 && UnicodeIndex < NumRects)
+		if (NumRects > 0 && GlyphIndex >= 0 && GlyphIndex < NumRects)
 		{
-			const FVector4& UVRect = TextureUvs[UnicodeIndex];
+			const FVector4f& UVRect = TextureUvs[GlyphIndex];
 			OutUSize.SetAndAdvance(UVRect.X);
 			OutVSize.SetAndAdvance(UVRect.Y);
 			OutUStart.SetAndAdvance(UVRect.Z);
@@ -983,8 +1230,8 @@ void UNTTDataInterface::GetCharacterUVVM(FVectorVMExternalFunctionContext& Conte
 
 			if (i < 4)
 			{
-				UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT DI: VM idx=%d UnicodeIndex=%d -> CharacterTextureUV=[%s]"),
-					i, UnicodeIndex, *UVRect.ToString());
+				UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT DI: VM idx=%d GlyphIndex=%d -> CharacterTextureUV=[%s]"),
+					i, GlyphIndex, *UVRect.ToString());
 			}
 		}
 		else
@@ -995,10 +1242,11 @@ void UNTTDataInterface::GetCharacterUVVM(FVectorVMExternalFunctionContext& Conte
 			OutUStart.SetAndAdvance(0.0f);
 			OutVStart.SetAndAdvance(0.0f);
 
-			if (i < 4)
+			// Characters the font has no glyph for are INDEX_NONE and expected; only an index past the glyph table is a problem.
+			if (i < 4 && GlyphIndex != INDEX_NONE)
 			{
-				UE_LOG(LogNiagaraTextToolkit, Warning, TEXT("NTT DI: VM idx=%d UnicodeIndex=%d out of bounds (NumRects=%d) - returning zeros"),
-					i, UnicodeIndex, NumRects);
+				UE_LOG(LogNiagaraTextToolkit, Warning, TEXT("NTT DI: VM idx=%d GlyphIndex=%d out of bounds (NumRects=%d) - returning zeros"),
+					i, GlyphIndex, NumRects);
 			}
 		}
 	}
@@ -1010,8 +1258,8 @@ void UNTTDataInterface::GetCharacterPositionVM(FVectorVMExternalFunctionContext&
 	FNDIInputParam<int32> InCharacterIndex(Context);
 	FNDIOutputParam<FVector3f> OutPosition(Context);
 
-	const TArray<FVector2f>& Positions = InstData.Get()->CharacterPositions;
-	const int32 NumChars = InstData.Get()->Unicode.Num();
+	const TArray<FVector2f>& Positions = InstData.Get()->Layout->CharacterPositions;
+	const int32 NumChars = InstData.Get()->Layout->Unicode.Num();
 
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
 	{
@@ -1041,7 +1289,7 @@ void UNTTDataInterface::GetTextCharacterCountVM(FVectorVMExternalFunctionContext
 	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
 	FNDIOutputParam<int32> OutLen(Context);
 
-	const int32 NumChars = InstData.Get()->Unicode.Num();
+	const int32 NumChars = InstData.Get()->Layout->Unicode.Num();
 
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
 	{
@@ -1054,7 +1302,7 @@ void UNTTDataInterface::GetTextLineCountVM(FVectorVMExternalFunctionContext& Con
 	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
 	FNDIOutputParam<int32> OutTotalLines(Context);
 
-	const int32 NumLines = InstData.Get()->LineStartIndices.Num();
+	const int32 NumLines = InstData.Get()->Layout->LineStartIndices.Num();
 
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
 	{
@@ -1064,8 +1312,8 @@ void UNTTDataInterface::GetTextLineCountVM(FVectorVMExternalFunctionContext& Con
 
 static int32 GetLineCharacterCountInternal(const FNDIFontUVInfoInstanceData* Data, int32 LineIndex)
 {
-	const TArray<int32>& LineCharacterCounts = Data->LineCharacterCounts;
-	const int32 NumLines = Data->LineStartIndices.Num();
+	const TArray<int32>& LineCharacterCounts = Data->Layout->LineCharacterCounts;
+	const int32 NumLines = Data->Layout->LineStartIndices.Num();
 
 	if (NumLines > 0 && LineIndex >= 0 && LineIndex < NumLines && LineCharacterCounts.IsValidIndex(LineIndex))
 	{
@@ -1096,7 +1344,7 @@ void UNTTDataInterface::GetTextWordCountVM(FVectorVMExternalFunctionContext& Con
 	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
 	FNDIOutputParam<int32> OutWordCount(Context);
 
-	const int32 NumWords = InstData.Get()->WordStartIndices.Num();
+	const int32 NumWords = InstData.Get()->Layout->WordStartIndices.Num();
 
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
 	{
@@ -1106,8 +1354,8 @@ void UNTTDataInterface::GetTextWordCountVM(FVectorVMExternalFunctionContext& Con
 
 static int32 GetWordCharacterCountInternal(const FNDIFontUVInfoInstanceData* Data, int32 WordIndex)
 {
-	const TArray<int32>& WordCharacterCounts = Data->WordCharacterCounts;
-	const int32 NumWords = Data->WordStartIndices.Num();
+	const TArray<int32>& WordCharacterCounts = Data->Layout->WordCharacterCounts;
+	const int32 NumWords = Data->Layout->WordStartIndices.Num();
 
 	if (NumWords > 0 && WordIndex >= 0 && WordIndex < NumWords && WordCharacterCounts.IsValidIndex(WordIndex))
 	{
@@ -1119,10 +1367,10 @@ static int32 GetWordCharacterCountInternal(const FNDIFontUVInfoInstanceData* Dat
 
 static int32 GetWordTrailingWhitespaceCountInternal(const FNDIFontUVInfoInstanceData* Data, int32 WordIndex)
 {
-	const TArray<int32>& WordStartIndices = Data->WordStartIndices;
-	const TArray<int32>& WordCharacterCounts = Data->WordCharacterCounts;
+	const TArray<int32>& WordStartIndices = Data->Layout->WordStartIndices;
+	const TArray<int32>& WordCharacterCounts = Data->Layout->WordCharacterCounts;
 	const int32 NumWords = WordStartIndices.Num();
-	const int32 TotalChars = Data->Unicode.Num();
+	const int32 TotalChars = Data->Layout->Unicode.Num();
 
 	if (NumWords > 0 && WordIndex >= 0 && WordIndex < NumWords &&
 		WordCharacterCounts.IsValidIndex(WordIndex) && WordStartIndices.IsValidIndex(WordIndex))
@@ -1192,11 +1440,11 @@ void UNTTDataInterface::GetCharacterCountInWordRangeVM(FVectorVMExternalFunction
 	FNDIInputParam<int32> InEndWordIndex(Context);
 	FNDIOutputParam<int32> OutCharacterCountInRange(Context);
 
-	const TArray<int32>& WordStartIndices = InstData.Get()->WordStartIndices;
-	const TArray<int32>& WordCharacterCounts = InstData.Get()->WordCharacterCounts;
-	const int32 NumWords = WordStartIndices.Num();
-	const int32 TotalChars = InstData.Get()->Unicode.Num();
+	// When whitespace isn't filtered, each word's trailing whitespace counts towards the range
+	const FNTTTextLayout& Layout = *InstData.Get()->Layout;
 	const bool bFilterWhitespace = InstData.Get()->bFilterWhitespaceCharactersValue;
+	const TArray<int32>& PrefixSums = bFilterWhitespace ? Layout.WordCharacterPrefixSums : Layout.WordCharacterPrefixSumsWithWhitespace;
+	const int32 NumWords = Layout.WordStartIndices.Num();
 
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
 	{
@@ -1211,23 +1459,13 @@ void UNTTDataInterface::GetCharacterCountInWordRangeVM(FVectorVMExternalFunction
 			StartWordIndex = StartWordIndex % NumWords;
 			EndWordIndex = StartWordIndex + Delta;
 
-			const int32 StartIndex = StartWordIndex;
+			// Words before the first contribute nothing
+			const int32 StartIndex = FMath::Max(StartWordIndex, 0);
 			const int32 EndIndex   = FMath::Clamp(EndWordIndex, 0, NumWords - 1);
 
 			if (StartIndex <= EndIndex)
 			{
-				for (int32 WordIndex = StartIndex; WordIndex <= EndIndex; ++WordIndex)
-				{
-					const FNDIFontUVInfoInstanceData* Data = InstData.Get();
-					const int32 CharCount = GetWordCharacterCountInternal(Data, WordIndex);
-					TotalInRange += CharCount;
-
-					if (!bFilterWhitespace)
-					{
-						const int32 TrailingSpace = GetWordTrailingWhitespaceCountInternal(Data, WordIndex);
-						TotalInRange += TrailingSpace;
-					}
-				}
+				TotalInRange = PrefixSums[EndIndex + 1] - PrefixSums[StartIndex];
 			}
 		}
 
@@ -1242,7 +1480,8 @@ void UNTTDataInterface::GetCharacterCountInLineRangeVM(FVectorVMExternalFunction
 	FNDIInputParam<int32> InEndLineIndex(Context);
 	FNDIOutputParam<int32> OutCharacterCountInLineRange(Context);
 
-	const int32 NumLines = InstData.Get()->LineStartIndices.Num();
+	const TArray<int32>& PrefixSums = InstData.Get()->Layout->LineCharacterPrefixSums;
+	const int32 NumLines = InstData.Get()->Layout->LineStartIndices.Num();
 
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
 	{
@@ -1257,18 +1496,13 @@ void UNTTDataInterface::GetCharacterCountInLineRangeVM(FVectorVMExternalFunction
 			StartLineIndex = StartLineIndex % NumLines;
 			EndLineIndex = StartLineIndex + Delta;
 
-			const int32 StartIndex = StartLineIndex;
+			// Lines before the first contribute nothing
+			const int32 StartIndex = FMath::Max(StartLineIndex, 0);
 			const int32 EndIndex   = FMath::Clamp(EndLineIndex, 0, NumLines - 1);
 
 			if (StartIndex <= EndIndex)
 			{
-				const FNDIFontUVInfoInstanceData* Data = InstData.Get();
-
-				for (int32 LineIndex = StartIndex; LineIndex <= EndIndex; ++LineIndex)
-				{
-					const int32 CharCount = GetLineCharacterCountInternal(Data, LineIndex);
-					TotalInRange += CharCount;
-				}
+				TotalInRange = PrefixSums[EndIndex + 1] - PrefixSums[StartIndex];
 			}
 		}
 
@@ -1282,10 +1516,10 @@ void UNTTDataInterface::GetCharacterSpriteSizeVM(FVectorVMExternalFunctionContex
 	FNDIInputParam<int32> InCharacterIndex(Context);
 	FNDIOutputParam<FVector2f> OutSpriteSize(Context);
 
-	const TArray<int32>& Unicode = InstData.Get()->Unicode;
-	const TArray<FVector2f>& SpriteSizes = InstData.Get()->CharacterSpriteSizes;
+	const TArray<int32>& GlyphIndices = InstData.Get()->Layout->GlyphIndices;
+	const TArray<FVector2f>& SpriteSizes = InstData.Get()->GlyphTable->CharacterSpriteSizes;
 	const int32 NumSizes = SpriteSizes.Num();
-	const int32 NumChars = Unicode.Num();
+	const int32 NumChars = GlyphIndices.Num();
 
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
 	{
@@ -1296,11 +1530,11 @@ void UNTTDataInterface::GetCharacterSpriteSizeVM(FVectorVMExternalFunctionContex
 			CharacterIndex = CharacterIndex % NumChars;
 		}
 
-		const int32 UnicodeIndex = (Unicode.IsValidIndex(CharacterIndex)) ? Unicode[CharacterIndex] : -1;
+		const int32 GlyphIndex = (GlyphIndices.IsValidIndex(CharacterIndex)) ? GlyphIndices[CharacterIndex] : -1;
 
-		if (NumSizes > 0 && UnicodeIndex >= 0 && UnicodeIndex < NumSizes)
+		if (NumSizes > 0 && GlyphIndex >= 0 && GlyphIndex < NumSizes)
 		{
-			const FVector2f& Size = SpriteSizes[UnicodeIndex];
+			const FVector2f& Size = SpriteSizes[GlyphIndex];
 			OutSpriteSize.SetAndAdvance(Size);
 		}
 		else
@@ -1315,7 +1549,7 @@ void UNTTDataInterface::GetTextHeightVM(FVectorVMExternalFunctionContext& Contex
 	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
 	FNDIOutputParam<float> OutTextHeight(Context);
 
-	const float Height = InstData.Get()->TotalTextHeight;
+	const float Height = InstData.Get()->Layout->TotalTextHeight;
 
 	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
 	{
@@ -1323,6 +1557,369 @@ void UNTTDataInterface::GetTextHeightVM(FVectorVMExternalFunctionContext& Contex
 	}
 }
 
+void UNTTDataInterface::GetCharacterPageVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InCharacterIndex(Context);
+	FNDIOutputParam<int32> OutPage(Context);
+
+	const TArray<int32>& GlyphIndices = InstData.Get()->Layout->GlyphIndices;
+	const TArray<int32>& TexturePages = InstData.Get()->GlyphTable->GlyphTexturePages;
+	const int32 NumChars = GlyphIndices.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 CharacterIndex = InCharacterIndex.GetAndAdvance();
+
+		if (NumChars > 0)
+		{
+			CharacterIndex = CharacterIndex % NumChars;
+		}
+
+		const int32 GlyphIndex = (GlyphIndices.IsValidIndex(CharacterIndex)) ? GlyphIndices[CharacterIndex] : -1;
+		OutPage.SetAndAdvance(TexturePages.IsValidIndex(GlyphIndex) ? TexturePages[GlyphIndex] : 0);
+	}
+}
+
+void UNTTDataInterface::GetCharacterColorVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InCharacterIndex(Context);
+	FNDIOutputParam<FLinearColor> OutColor(Context);
+
+	const TArray<FColor>& Colors = InstData.Get()->Layout->CharacterColors;
+	const int32 NumChars = Colors.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 CharacterIndex = InCharacterIndex.GetAndAdvance();
+
+		if (NumChars > 0)
+		{
+			CharacterIndex = CharacterIndex % NumChars;
+		}
+
+		// Markup colors are written in sRGB, like color pickers show them
+		OutColor.SetAndAdvance(Colors.IsValidIndex(CharacterIndex) ? FLinearColor(Colors[CharacterIndex]) : FLinearColor::White);
+	}
+}
+
+void UNTTDataInterface::GetCharacterScaleVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InCharacterIndex(Context);
+	FNDIOutputParam<float> OutScale(Context);
+
+	const TArray<float>& Scales = InstData.Get()->Layout->CharacterScales;
+	const int32 NumChars = Scales.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 CharacterIndex = InCharacterIndex.GetAndAdvance();
+
+		if (NumChars > 0)
+		{
+			CharacterIndex = CharacterIndex % NumChars;
+		}
+
+		OutScale.SetAndAdvance(Scales.IsValidIndex(CharacterIndex) ? Scales[CharacterIndex] : 1.0f);
+	}
+}
+
+void UNTTDataInterface::GetCharacterStyleVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InCharacterIndex(Context);
+	FNDIOutputParam<int32> OutStyle(Context);
+
+	const TArray<int32>& Styles = InstData.Get()->Layout->CharacterStyles;
+	const int32 NumChars = Styles.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 CharacterIndex = InCharacterIndex.GetAndAdvance();
+
+		if (NumChars > 0)
+		{
+			CharacterIndex = CharacterIndex % NumChars;
+		}
+
+		OutStyle.SetAndAdvance(Styles.IsValidIndex(CharacterIndex) ? Styles[CharacterIndex] : INDEX_NONE);
+	}
+}
+
+void UNTTDataInterface::GetCharacterLineIndexVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InCharacterIndex(Context);
+	FNDIOutputParam<int32> OutLineIndex(Context);
+	FNDIOutputParam<int32> OutIndexInLine(Context);
+
+	const TArray<int32>& CharacterLineIndices = InstData.Get()->Layout->CharacterLineIndices;
+	const TArray<int32>& LineStartIndices = InstData.Get()->Layout->LineStartIndices;
+	const int32 NumChars = CharacterLineIndices.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 CharacterIndex = InCharacterIndex.GetAndAdvance();
+
+		if (NumChars > 0)
+		{
+			CharacterIndex = CharacterIndex % NumChars;
+		}
+
+		if (CharacterLineIndices.IsValidIndex(CharacterIndex))
+		{
+			const int32 LineIndex = CharacterLineIndices[CharacterIndex];
+			OutLineIndex.SetAndAdvance(LineIndex);
+			OutIndexInLine.SetAndAdvance(CharacterIndex - LineStartIndices[LineIndex]);
+		}
+		else
+		{
+			OutLineIndex.SetAndAdvance(0);
+			OutIndexInLine.SetAndAdvance(0);
+		}
+	}
+}
+
+void UNTTDataInterface::GetCharacterWordIndexVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InCharacterIndex(Context);
+	FNDIOutputParam<int32> OutWordIndex(Context);
+	FNDIOutputParam<int32> OutIndexInWord(Context);
+
+	const TArray<int32>& CharacterWordIndices = InstData.Get()->Layout->CharacterWordIndices;
+	const TArray<int32>& WordStartIndices = InstData.Get()->Layout->WordStartIndices;
+	const int32 NumChars = CharacterWordIndices.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 CharacterIndex = InCharacterIndex.GetAndAdvance();
+
+		if (NumChars > 0)
+		{
+			CharacterIndex = CharacterIndex % NumChars;
+		}
+
+		const int32 WordIndex = CharacterWordIndices.IsValidIndex(CharacterIndex) ? CharacterWordIndices[CharacterIndex] : INDEX_NONE;
+		OutWordIndex.SetAndAdvance(WordIndex);
+		OutIndexInWord.SetAndAdvance(WordIndex != INDEX_NONE ? CharacterIndex - WordStartIndices[WordIndex] : INDEX_NONE);
+	}
+}
+
+void UNTTDataInterface::GetCharacterTransformVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InCharacterIndex(Context);
+	FNDIOutputParam<FVector3f> OutPosition(Context);
+	FNDIOutputParam<FQuat4f> OutRotation(Context);
+	FNDIOutputParam<float> OutAngle(Context);
+
+	const TArray<FVector2f>& Positions = InstData.Get()->Layout->CharacterPositions;
+	const TArray<float>& Rotations = InstData.Get()->Layout->CharacterRotations;
+	const int32 NumChars = Positions.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 CharacterIndex = InCharacterIndex.GetAndAdvance();
+
+		if (NumChars > 0)
+		{
+			CharacterIndex = CharacterIndex % NumChars;
+		}
+
+		// Flipped the same way as GetCharacterPositionVM. Layout rotations turn +X towards +Y in text space, which maps to
+		// turning world +Y towards +Z, a positive rotation about X.
+		const FVector2f Position2 = Positions.IsValidIndex(CharacterIndex) ? Positions[CharacterIndex] : FVector2f(0.0f, 0.0f);
+		const float Rotation = Rotations.IsValidIndex(CharacterIndex) ? Rotations[CharacterIndex] : 0.0f;
+		OutPosition.SetAndAdvance(FVector3f(0.0f, -Position2.X, -Position2.Y));
+		OutRotation.SetAndAdvance(FQuat4f(FVector3f(1.0f, 0.0f, 0.0f), Rotation));
+		OutAngle.SetAndAdvance(FMath::RadiansToDegrees(Rotation));
+	}
+}
+
+void UNTTDataInterface::GetLineWidthVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InLineIndex(Context);
+	FNDIOutputParam<float> OutLineWidth(Context);
+
+	const TArray<float>& LineWidths = InstData.Get()->Layout->LineWidths;
+	const int32 NumLines = LineWidths.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 LineIndex = InLineIndex.GetAndAdvance();
+
+		if (NumLines > 0)
+		{
+			LineIndex = LineIndex % NumLines;
+		}
+
+		OutLineWidth.SetAndAdvance(LineWidths.IsValidIndex(LineIndex) ? LineWidths[LineIndex] : 0.0f);
+	}
+}
+
+void UNTTDataInterface::GetLineTopVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InLineIndex(Context);
+	FNDIOutputParam<float> OutLineTop(Context);
+	FNDIOutputParam<float> OutLineHeight(Context);
+
+	const FNTTTextLayout& Layout = *InstData.Get()->Layout;
+	const int32 NumLines = Layout.LineTops.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 LineIndex = InLineIndex.GetAndAdvance();
+
+		if (NumLines > 0)
+		{
+			LineIndex = LineIndex % NumLines;
+		}
+
+		// Flipped the same way as GetCharacterPositionVM, so the top is the line's highest Z
+		if (Layout.LineTops.IsValidIndex(LineIndex))
+		{
+			OutLineTop.SetAndAdvance(-(Layout.LineTops[LineIndex] + Layout.BlockOffsetY));
+			OutLineHeight.SetAndAdvance(Layout.LineHeights[LineIndex]);
+		}
+		else
+		{
+			OutLineTop.SetAndAdvance(0.0f);
+			OutLineHeight.SetAndAdvance(0.0f);
+		}
+	}
+}
+
+void UNTTDataInterface::GetWordBoundsVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InWordIndex(Context);
+	FNDIOutputParam<FVector2f> OutBoundsMin(Context);
+	FNDIOutputParam<FVector2f> OutBoundsMax(Context);
+
+	const TArray<FVector4f>& WordBounds = InstData.Get()->Layout->WordBounds;
+	const int32 NumWords = WordBounds.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 WordIndex = InWordIndex.GetAndAdvance();
+
+		if (NumWords > 0)
+		{
+			WordIndex = WordIndex % NumWords;
+		}
+
+		// Flipping both axes swaps which corner is the minimum
+		const FVector4f Bounds = WordBounds.IsValidIndex(WordIndex) ? WordBounds[WordIndex] : FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		OutBoundsMin.SetAndAdvance(FVector2f(-Bounds.Z, -Bounds.W));
+		OutBoundsMax.SetAndAdvance(FVector2f(-Bounds.X, -Bounds.Y));
+	}
+}
+
+void UNTTDataInterface::GetTextBoundsVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIOutputParam<FVector2f> OutBoundsMin(Context);
+	FNDIOutputParam<FVector2f> OutBoundsMax(Context);
+
+	const FVector4f Bounds = InstData.Get()->Layout->TextBounds;
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		OutBoundsMin.SetAndAdvance(FVector2f(-Bounds.Z, -Bounds.W));
+		OutBoundsMax.SetAndAdvance(FVector2f(-Bounds.X, -Bounds.Y));
+	}
+}
+
+void UNTTDataInterface::GetTextGenerationVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIOutputParam<int32> OutGeneration(Context);
+
+	const int32 Generation = static_cast<int32>(InstData.Get()->Generation);
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		OutGeneration.SetAndAdvance(Generation);
+	}
+}
+
+void UNTTDataInterface::GetCharacterRecordVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIInputParam<int32> InCharacterIndex(Context);
+	FNDIOutputParam<FVector3f> OutPosition(Context);
+	FNDIOutputParam<FVector2f> OutSpriteSize(Context);
+	FNDIOutputParam<float> OutUSize(Context);
+	FNDIOutputParam<float> OutVSize(Context);
+	FNDIOutputParam<float> OutUStart(Context);
+	FNDIOutputParam<float> OutVStart(Context);
+	FNDIOutputParam<int32> OutLineIndex(Context);
+	FNDIOutputParam<int32> OutWordIndex(Context);
+
+	// The VM reads the layout's own tables; the packed records only exist for the GPU.
+	const FNTTTextLayout& Layout = *InstData.Get()->Layout;
+	const FNTTGlyphTable& GlyphTable = *InstData.Get()->GlyphTable;
+	const int32 NumGlyphs = GlyphTable.NumGlyphs();
+	const int32 NumChars = Layout.GlyphIndices.Num();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		int32 CharacterIndex = InCharacterIndex.GetAndAdvance();
+		if (NumChars > 0)
+		{
+			CharacterIndex = CharacterIndex % NumChars;
+		}
+
+		// Same as the individual functions, a negative index reads as a character without a glyph
+		if (!Layout.GlyphIndices.IsValidIndex(CharacterIndex))
+		{
+			OutPosition.SetAndAdvance(FVector3f(0.0f, 0.0f, 0.0f));
+			OutSpriteSize.SetAndAdvance(FVector2f(0.0f, 0.0f));
+			OutUSize.SetAndAdvance(0.0f);
+			OutVSize.SetAndAdvance(0.0f);
+			OutUStart.SetAndAdvance(0.0f);
+			OutVStart.SetAndAdvance(0.0f);
+			OutLineIndex.SetAndAdvance(0);
+			OutWordIndex.SetAndAdvance(INDEX_NONE);
+			continue;
+		}
+
+		// Flipped the same way as GetCharacterPositionVM
+		const FVector2f Position2 = Layout.CharacterPositions[CharacterIndex];
+		OutPosition.SetAndAdvance(FVector3f(0.0f, -Position2.X, -Position2.Y));
+
+		const int32 GlyphIndex = Layout.GlyphIndices[CharacterIndex];
+		const bool bHasGlyph = GlyphIndex >= 0 && GlyphIndex < NumGlyphs;
+		const FVector4f UVRect = bHasGlyph ? GlyphTable.CharacterTextureUvs[GlyphIndex] : FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		OutSpriteSize.SetAndAdvance(bHasGlyph ? GlyphTable.CharacterSpriteSizes[GlyphIndex] : FVector2f(0.0f, 0.0f));
+		OutUSize.SetAndAdvance(UVRect.X);
+		OutVSize.SetAndAdvance(UVRect.Y);
+		OutUStart.SetAndAdvance(UVRect.Z);
+		OutVStart.SetAndAdvance(UVRect.W);
+
+		OutLineIndex.SetAndAdvance(Layout.CharacterLineIndices[CharacterIndex]);
+		OutWordIndex.SetAndAdvance(Layout.CharacterWordIndices[CharacterIndex]);
+	}
+}
+
+void UNTTDataInterface::IsTextReadyVM(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFontUVInfoInstanceData> InstData(Context);
+	FNDIOutputParam<bool> OutIsReady(Context);
+
+	const bool bReady = !InstData.Get()->PendingLayout.IsValid();
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		OutIsReady.SetAndAdvance(bReady);
+	}
+}
+
 #if WITH_EDITORONLY_DATA
 
 bool UNTTDataInterface::AppendCompileHash(FNiagaraCompileHashVisitor* InVisitor) const
@@ -1350,7 +1947,21 @@ bool UNTTDataInterface::GetFunctionHLSL(const FNiagaraDataInterfaceGPUParamInfo&
 		|| FunctionInfo.DefinitionName == GetFilterWhitespaceCharactersName
 		|| FunctionInfo.DefinitionName == GetCharacterCountInWordRangeName
 		|| FunctionInfo.DefinitionName == GetCharacterCountInLineRangeName
-		|| FunctionInfo.DefinitionName == GetTextHeightName;
+		|| FunctionInfo.DefinitionName == GetTextHeightName
+		|| FunctionInfo.DefinitionName == GetCharacterPageName
+		|| FunctionInfo.DefinitionName == GetCharacterColorName
+		|| FunctionInfo.DefinitionName == GetCharacterScaleName
+		|| FunctionInfo.DefinitionName == GetCharacterStyleName
+		|| FunctionInfo.DefinitionName == GetCharacterLineIndexName
+		|| FunctionInfo.DefinitionName == GetCharacterWordIndexName
+		|| FunctionInfo.DefinitionName == GetCharacterTransformName
+		|| FunctionInfo.DefinitionName == GetLineWidthName
+		|| FunctionInfo.DefinitionName == GetLineTopName
+		|| FunctionInfo.DefinitionName == GetWordBoundsName
+		|| FunctionInfo.DefinitionName == GetTextBoundsName
+		|| FunctionInfo.DefinitionName == GetTextGenerationName
+		|| FunctionInfo.DefinitionName == GetCharacterRecordName
+		|| FunctionInfo.DefinitionName == IsTextReadyName;
 }
 
 void UNTTDataInterface::GetParameterDefinitionHLSL(const FNiagaraDataInterfaceGPUParamInfo& ParamInfo, FString& OutHLSL)
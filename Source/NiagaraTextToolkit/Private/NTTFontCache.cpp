@@ -0,0 +1,261 @@
+// Property of Lucian Tranc
+
+#include "NTTFontCache.h"
+#include "NTTDataInterface.h"
+#include "Engine/Font.h"
+#include "Engine/Texture2D.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+
+int32 FNTTGlyphTable::AddGlyph(int32 Codepoint, const FVector4f& TextureUv, const FVector2f& SpriteSize, int32 VerticalOffset, int32 TexturePage)
+{
+	check(Codepoint >= 0 && Codepoint < NumCodepointPages * CodepointPageSize);
+
+	if (CodepointPageOffsets.Num() == 0)
+	{
+		CodepointPageOffsets.Init(INDEX_NONE, NumCodepointPages);
+	}
+
+	const int32 Page = Codepoint >> CodepointPageBits;
+	if (CodepointPageOffsets[Page] == INDEX_NONE)
+	{
+		CodepointPageOffsets[Page] = CodepointPages.Num();
+		CodepointPages.AddUninitialized(CodepointPageSize);
+		for (int32 i = CodepointPageOffsets[Page]; i < CodepointPages.Num(); ++i)
+		{
+			CodepointPages[i] = INDEX_NONE;
+		}
+	}
+
+	const int32 GlyphIndex = CharacterSpriteSizes.Num();
+	CodepointPages[CodepointPageOffsets[Page] + (Codepoint & (CodepointPageSize - 1))] = GlyphIndex;
+
+	GlyphCodepoints.Add(Codepoint);
+	CharacterTextureUvs.Add(TextureUv);
+	CharacterSpriteSizes.Add(SpriteSize);
+	VerticalOffsets.Add(VerticalOffset);
+	GlyphTexturePages.Add(TexturePage);
+	MaxGlyphHeight = FMath::Max(MaxGlyphHeight, SpriteSize.Y);
+
+	return GlyphIndex;
+}
+
+void FNTTGlyphTable::Serialize(FArchive& Ar)
+{
+	GlyphCodepoints.BulkSerialize(Ar);
+	CharacterTextureUvs.BulkSerialize(Ar);
+	CharacterSpriteSizes.BulkSerialize(Ar);
+	VerticalOffsets.BulkSerialize(Ar);
+	GlyphTexturePages.BulkSerialize(Ar);
+	CodepointPageOffsets.BulkSerialize(Ar);
+	CodepointPages.BulkSerialize(Ar);
+	Ar << NumTexturePages;
+	Ar << Kerning;
+	Ar << MaxGlyphHeight;
+}
+
+FNTTFontCache& FNTTFontCache::Get()
+{
+	static FNTTFontCache Instance;
+	return Instance;
+}
+
+FNTTFontCache::FNTTFontCache()
+	: EmptyGlyphTable(MakeShared<const FNTTGlyphTable, ESPMode::ThreadSafe>())
+{
+}
+
+void FNTTFontCache::Initialize()
+{
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FNTTFontCache::OnPostGarbageCollect);
+#if WITH_EDITOR
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FNTTFontCache::OnObjectPropertyChanged);
+#endif
+}
+
+void FNTTFontCache::Shutdown()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+#endif
+
+	FScopeLock Lock(&CacheLock);
+	GlyphTables.Empty();
+}
+
+bool FNTTFontCache::FindOrAdd(const UFont* FontAsset, FNTTGlyphTablePtr& OutGlyphTable)
+{
+	OutGlyphTable = EmptyGlyphTable;
+
+	const TObjectKey<UFont> Key(FontAsset);
+
+	if (FontAsset)
+	{
+		FScopeLock Lock(&CacheLock);
+		if (const FNTTGlyphTablePtr* Found = GlyphTables.Find(Key))
+		{
+			OutGlyphTable = *Found;
+			return true;
+		}
+	}
+
+	TSharedPtr<FNTTGlyphTable, ESPMode::ThreadSafe> NewGlyphTable = MakeShared<FNTTGlyphTable, ESPMode::ThreadSafe>();
+	if (!BuildGlyphTable(FontAsset, *NewGlyphTable))
+	{
+		// Failed fonts are not cached so fixing the font asset takes effect on the next init.
+		return false;
+	}
+
+	FScopeLock Lock(&CacheLock);
+	// Another thread may have built the same table while we were unlocked; keep the first one so instances share it.
+	FNTTGlyphTablePtr& Entry = GlyphTables.FindOrAdd(Key);
+	if (!Entry.IsValid())
+	{
+		Entry = NewGlyphTable;
+		UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT Font Cache: Built glyph table for '%s' (%d glyphs, %d codepoint pages)"),
+			*GetNameSafe(FontAsset), NewGlyphTable->NumGlyphs(), NewGlyphTable->CodepointPages.Num() / FNTTGlyphTable::CodepointPageSize);
+	}
+	OutGlyphTable = Entry;
+	return true;
+}
+
+void FNTTFontCache::Invalidate(const UFont* FontAsset)
+{
+	if (!FontAsset)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CacheLock);
+	if (GlyphTables.Remove(TObjectKey<UFont>(FontAsset)) > 0)
+	{
+		UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT Font Cache: Invalidated glyph table for '%s'"), *GetNameSafe(FontAsset));
+	}
+}
+
+void FNTTFontCache::OnPostGarbageCollect()
+{
+	FScopeLock Lock(&CacheLock);
+	for (auto It = GlyphTables.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+#if WITH_EDITOR
+void FNTTFontCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Reimporting a font goes through PostEditChange, so this also catches reimports.
+	if (const UFont* ChangedFont = Cast<UFont>(Object))
+	{
+		Invalidate(ChangedFont);
+	}
+}
+#endif
+
+bool FNTTFontCache::BuildGlyphTable(const UFont* FontAsset, FNTTGlyphTable& OutGlyphTable)
+{
+	// Only offline cached fonts have the Characters array populated
+	if (FontAsset && FontAsset->FontCacheType == EFontCacheType::Offline)
+	{
+		// Glyphs can live on any texture page of the font, so normalize each glyph against the size of its own page.
+		const int32 NumTexturePages = FontAsset->Textures.Num();
+		TArray<FVector2f> InvTextureSizes;
+		InvTextureSizes.Init(FVector2f(1.0f, 1.0f), NumTexturePages);
+
+		for (int32 PageIndex = 0; PageIndex < NumTexturePages; ++PageIndex)
+		{
+			const UTexture2D* FontTexture = Cast<UTexture2D>(FontAsset->Textures[PageIndex]);
+			const float TexW = FontTexture ? static_cast<float>(FontTexture->GetSizeX()) : 0.0f;
+			const float TexH = FontTexture ? static_cast<float>(FontTexture->GetSizeY()) : 0.0f;
+			if (TexW > 0.0f && TexH > 0.0f)
+			{
+				InvTextureSizes[PageIndex] = FVector2f(1.0f / TexW, 1.0f / TexH);
+			}
+			else
+			{
+				UE_LOG(LogNiagaraTextToolkit, Warning,
+					TEXT("NTT DI: Font '%s' texture page %d has invalid size (%f x %f) - UVs on this page will not be normalized"),
+					*GetNameSafe(FontAsset), PageIndex, TexW, TexH);
+			}
+		}
+
+		if (NumTexturePages == 0)
+		{
+			UE_LOG(LogNiagaraTextToolkit, Warning,
+				TEXT("NTT DI: Font '%s' has no textures - UVs will not be normalized"),
+				*GetNameSafe(FontAsset));
+		}
+
+		OutGlyphTable.NumTexturePages = NumTexturePages;
+
+		// Remapped fonts store glyphs compactly and map codepoints through CharRemap; otherwise Characters is indexed by codepoint
+		// and contains empty entries for every codepoint the font wasn't imported with.
+		TArray<TPair<int32, int32>> CodepointToCharacter;
+		if (FontAsset->IsRemapped)
+		{
+			CodepointToCharacter.Reserve(FontAsset->CharRemap.Num());
+			for (const TPair<uint16, uint16>& Remap : FontAsset->CharRemap)
+			{
+				if (FontAsset->Characters.IsValidIndex(Remap.Value))
+				{
+					CodepointToCharacter.Emplace(Remap.Key, Remap.Value);
+				}
+			}
+			CodepointToCharacter.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B) { return A.Key < B.Key; });
+		}
+		else
+		{
+			const int32 NumCharacters = FMath::Min(FontAsset->Characters.Num(), FNTTGlyphTable::NumCodepointPages * FNTTGlyphTable::CodepointPageSize);
+			for (int32 Codepoint = 0; Codepoint < NumCharacters; ++Codepoint)
+			{
+				const FFontCharacter& FontChar = FontAsset->Characters[Codepoint];
+				if (FontChar.USize > 0 || FontChar.VSize > 0)
+				{
+					CodepointToCharacter.Emplace(Codepoint, Codepoint);
+				}
+			}
+		}
+
+		// Copy data from FFontCharacter array to our arrays
+		const int32 NumGlyphs = CodepointToCharacter.Num();
+		OutGlyphTable.GlyphCodepoints.Reserve(NumGlyphs);
+		OutGlyphTable.CharacterTextureUvs.Reserve(NumGlyphs);
+		OutGlyphTable.CharacterSpriteSizes.Reserve(NumGlyphs);
+		OutGlyphTable.VerticalOffsets.Reserve(NumGlyphs);
+		OutGlyphTable.GlyphTexturePages.Reserve(NumGlyphs);
+
+		for (const TPair<int32, int32>& Mapping : CodepointToCharacter)
+		{
+			const FFontCharacter& FontChar = FontAsset->Characters[Mapping.Value];
+			const int32 TexturePage = static_cast<int32>(FontChar.TextureIndex);
+			const FVector2f InvTextureSize = InvTextureSizes.IsValidIndex(TexturePage) ? InvTextureSizes[TexturePage] : FVector2f(1.0f, 1.0f);
+
+			const float USizePx = static_cast<float>(FontChar.USize);
+			const float VSizePx = static_cast<float>(FontChar.VSize);
+			const float UStartPx = static_cast<float>(FontChar.StartU);
+			const float VStartPx = static_cast<float>(FontChar.StartV);
+
+			// Precompute normalized UVs so shaders/materials don't have to divide by texture resolution.
+			const float USizeNorm  = USizePx  * InvTextureSize.X;
+			const float VSizeNorm  = VSizePx  * InvTextureSize.Y;
+			const float UStartNorm = UStartPx * InvTextureSize.X;
+			const float VStartNorm = VStartPx * InvTextureSize.Y;
+
+			// UV layout: (USize, VSize, UStart, VStart) in 0-1 texture space. Sprite size is kept in pixels for layout / particle sizing.
+			OutGlyphTable.AddGlyph(Mapping.Key, FVector4f(USizeNorm, VSizeNorm, UStartNorm, VStartNorm), FVector2f(USizePx, VSizePx), FontChar.VerticalOffset, TexturePage);
+		}
+
+		OutGlyphTable.Kerning = FontAsset->Kerning;
+		return true;
+	}
+	else
+	{
+		UE_LOG(LogNiagaraTextToolkit, Warning, TEXT("NTT DI: Font '%s' is invalid or not an offline cached font - Characters array will be empty"), *GetNameSafe(FontAsset));
+		return false;
+	}
+}
@@ -0,0 +1,49 @@
+// Property of Lucian Tranc
+
+#include "NTTFontMetrics.h"
+#include "NTTDataInterface.h"
+#include "Engine/Font.h"
+
+// Bump whenever the layout of FNTTGlyphTable::Serialize changes; older assets load empty and need to be rebaked.
+static constexpr int32 NTTFontMetricsVersion = 1;
+
+UNTTFontMetrics::UNTTFontMetrics(FObjectInitializer const& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, GlyphTable(MakeShared<FNTTGlyphTable, ESPMode::ThreadSafe>())
+{
+}
+
+void UNTTFontMetrics::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	int32 Version = NTTFontMetricsVersion;
+	Ar << Version;
+
+	if (Ar.IsLoading())
+	{
+		// Load into a fresh table so instances holding the previous one never see it change.
+		TSharedPtr<FNTTGlyphTable, ESPMode::ThreadSafe> LoadedGlyphTable = MakeShared<FNTTGlyphTable, ESPMode::ThreadSafe>();
+		if (Version == NTTFontMetricsVersion)
+		{
+			LoadedGlyphTable->Serialize(Ar);
+		}
+		else
+		{
+			UE_LOG(LogNiagaraTextToolkit, Warning, TEXT("NTT Font Metrics: '%s' was baked with an unsupported version (%d, expected %d) - rebake it from the source font"),
+				*GetPathName(), Version, NTTFontMetricsVersion);
+		}
+		GlyphTable = LoadedGlyphTable;
+	}
+	else
+	{
+		GlyphTable->Serialize(Ar);
+	}
+}
+
+void UNTTFontMetrics::SetGlyphTable(FNTTGlyphTable&& InGlyphTable)
+{
+	GlyphTable = MakeShared<FNTTGlyphTable, ESPMode::ThreadSafe>(MoveTemp(InGlyphTable));
+	NumGlyphs = GlyphTable->NumGlyphs();
+	NumTexturePages = GlyphTable->NumTexturePages;
+}
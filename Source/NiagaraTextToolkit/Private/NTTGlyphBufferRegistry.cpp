@@ -0,0 +1,61 @@
+// Property of Lucian Tranc
+
+#include "NTTGlyphBufferRegistry.h"
+#include "NTTDataInterface.h"
+#include "NTTBufferPool.h"
+#include "RHICommandList.h"
+
+FNTTGlyphBufferRegistry& FNTTGlyphBufferRegistry::Get()
+{
+	static FNTTGlyphBufferRegistry Instance;
+	return Instance;
+}
+
+FShaderResourceViewRHIRef FNTTGlyphBufferRegistry::AddRef(FRHICommandListBase& RHICmdList, const FNTTGlyphTablePtr& GlyphTable)
+{
+	check(IsInRenderingThread());
+	check(GlyphTable.IsValid());
+
+	FEntry& Entry = Entries.FindOrAdd(GlyphTable.Get());
+	if (Entry.RefCount == 0)
+	{
+		const uint32 NumGlyphs = (uint32)GlyphTable->NumGlyphs();
+		const uint32 TotalFloats = FMath::Max(GetPagesOffset(NumGlyphs) + NumGlyphs, 1u);
+
+		Entry.GlyphTable = GlyphTable;
+		Entry.Buffer = FNTTBufferPool::Get().Acquire(RHICmdList, TEXT("NTT_GlyphBuffer"), sizeof(float), TotalFloats);
+
+		float* DestInfo = (float*)RHICmdList.LockBuffer(Entry.Buffer.Buffer, 0, TotalFloats * sizeof(float), RLM_WriteOnly);
+		if (NumGlyphs == 0)
+		{
+			DestInfo[0] = 0.0f;
+		}
+		else
+		{
+			// The glyph table arrays are already tightly packed floats/ints, so each section is a single copy.
+			FMemory::Memcpy(&DestInfo[GetUVsOffset(NumGlyphs)], GlyphTable->CharacterTextureUvs.GetData(), NumGlyphs * sizeof(FVector4f));
+			FMemory::Memcpy(&DestInfo[GetSizesOffset(NumGlyphs)], GlyphTable->CharacterSpriteSizes.GetData(), NumGlyphs * sizeof(FVector2f));
+			FMemory::Memcpy(&DestInfo[GetPagesOffset(NumGlyphs)], GlyphTable->GlyphTexturePages.GetData(), NumGlyphs * sizeof(int32));
+		}
+		RHICmdList.UnlockBuffer(Entry.Buffer.Buffer);
+
+		UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT Glyph Buffer (RT): Uploaded glyph buffer for table %p (%u glyphs)"), GlyphTable.Get(), NumGlyphs);
+	}
+
+	++Entry.RefCount;
+	return Entry.Buffer.SRV;
+}
+
+void FNTTGlyphBufferRegistry::Release(const FNTTGlyphTablePtr& GlyphTable)
+{
+	check(IsInRenderingThread());
+
+	if (FEntry* Entry = Entries.Find(GlyphTable.Get()))
+	{
+		if (--Entry->RefCount <= 0)
+		{
+			FNTTBufferPool::Get().Release(Entry->Buffer);
+			Entries.Remove(GlyphTable.Get());
+		}
+	}
+}
@@ -0,0 +1,370 @@
+// Property of Lucian Tranc
+
+#include "NTTTextBufferRegistry.h"
+#include "NTTDataInterface.h"
+#include "NTTBufferPool.h"
+#include "RHICommandList.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/Float16.h"
+
+static TAutoConsoleVariable<int32> CVarNTTTextBufferCompact(
+	TEXT("NTT.TextBuffer.Compact"),
+	1,
+	TEXT("Encode NTT text buffers with 16-bit indices and half float positions when the text fits, roughly halving their size. Applies to layouts built after the change."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarNTTTextBufferCharacterRecords(
+	TEXT("NTT.TextBuffer.CharacterRecords"),
+	1,
+	TEXT("Pack each character's position, sprite size, UVs, line and word into a 32 byte record GPU simulations fetch in two loads. Applies to layouts built after the change."),
+	ECVF_RenderThreadSafe);
+
+FNTTTextBufferRegistry& FNTTTextBufferRegistry::Get()
+{
+	static FNTTTextBufferRegistry Instance;
+	return Instance;
+}
+
+FNTTTextBufferRegistry::FOffsets FNTTTextBufferRegistry::GetOffsets(uint32 NumChars, uint32 NumLines, uint32 NumWords, uint32 NumStyledChars, uint32 NumRotatedChars, uint32 Flags)
+{
+	// Number of floats a section of Num indices or Num scales takes in the chosen encoding
+	const bool bCompactIndices = (Flags & Flag_CompactIndices) != 0;
+	const bool bHalfPositions = (Flags & Flag_HalfPositions) != 0;
+	auto IndexFloats = [bCompactIndices](uint32 Num) { return bCompactIndices ? (Num + 1) / 2 : Num; };
+	auto HalfFloats = [bHalfPositions](uint32 Num) { return bHalfPositions ? (Num + 1) / 2 : Num; };
+
+	FOffsets Offsets;
+	Offsets.Flags = Flags;
+	Offsets.GlyphIndices = 0;
+	Offsets.Positions = Offsets.GlyphIndices + IndexFloats(NumChars);
+	Offsets.LineStart = Offsets.Positions + (bHalfPositions ? NumChars : NumChars * 2);
+	Offsets.LineCount = Offsets.LineStart + IndexFloats(NumLines);
+	Offsets.WordStart = Offsets.LineCount + IndexFloats(NumLines);
+	Offsets.WordCount = Offsets.WordStart + IndexFloats(NumWords);
+	Offsets.CharacterLines = Offsets.WordCount + IndexFloats(NumWords);
+	Offsets.CharacterWords = Offsets.CharacterLines + IndexFloats(NumChars);
+	// Prefix sums have one more entry than there are lines or words
+	Offsets.LinePrefixSums = Offsets.CharacterWords + IndexFloats(NumChars);
+	Offsets.WordPrefixSums = Offsets.LinePrefixSums + IndexFloats(NumLines + 1);
+	Offsets.WordPrefixSumsWithWhitespace = Offsets.WordPrefixSums + IndexFloats(NumWords + 1);
+	Offsets.Colors = Offsets.WordPrefixSumsWithWhitespace + IndexFloats(NumWords + 1);
+	Offsets.Scales = Offsets.Colors + NumStyledChars;
+	Offsets.Styles = Offsets.Scales + HalfFloats(NumStyledChars);
+	Offsets.Rotations = Offsets.Styles + IndexFloats(NumStyledChars);
+	Offsets.LineWidths = Offsets.Rotations + HalfFloats(NumRotatedChars);
+	Offsets.LineTops = Offsets.LineWidths + NumLines;
+	Offsets.LineHeights = Offsets.LineTops + NumLines;
+	Offsets.WordBounds = Offsets.LineHeights + NumLines;
+	Offsets.TotalFloats = Offsets.WordBounds + NumWords * 4;
+	return Offsets;
+}
+
+uint32 FNTTTextBufferRegistry::GetCompactFlags(const FNTTTextLayout& Layout)
+{
+	uint32 Flags = 0;
+
+	// 0xFFFF is kept free to encode INDEX_NONE. Line and word starts and counts never exceed the character count.
+	const auto FitsUint16 = [](const TArray<int32>& Values)
+	{
+		for (const int32 Value : Values)
+		{
+			if (Value >= 0xFFFF)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+	if (Layout.Unicode.Num() < 0xFFFF && FitsUint16(Layout.GlyphIndices) && FitsUint16(Layout.CharacterStyles))
+	{
+		Flags |= Flag_CompactIndices;
+	}
+
+	// Below 1024 half floats are within a quarter of a pixel, well under what a glyph quad can show
+	static constexpr float MaxHalfCoordinate = 1024.0f;
+	bool bPositionsFit = true;
+	for (const FVector2f& Position : Layout.CharacterPositions)
+	{
+		if (FMath::Abs(Position.X) >= MaxHalfCoordinate || FMath::Abs(Position.Y) >= MaxHalfCoordinate)
+		{
+			bPositionsFit = false;
+			break;
+		}
+	}
+	if (bPositionsFit)
+	{
+		Flags |= Flag_HalfPositions;
+	}
+
+	return Flags;
+}
+
+// Writes Num indices, either as they are or as two uint16s per float
+static void WriteIndices(float* Dest, const int32* Src, uint32 Num, bool bCompact)
+{
+	if (!bCompact)
+	{
+		FMemory::Memcpy(Dest, Src, Num * sizeof(int32));
+		return;
+	}
+
+	uint32* DestWords = reinterpret_cast<uint32*>(Dest);
+	for (uint32 i = 0; i + 1 < Num; i += 2)
+	{
+		DestWords[i / 2] = (static_cast<uint32>(Src[i]) & 0xFFFF) | (static_cast<uint32>(Src[i + 1]) << 16);
+	}
+	if (Num & 1)
+	{
+		DestWords[Num / 2] = static_cast<uint32>(Src[Num - 1]) & 0xFFFF;
+	}
+}
+
+// Writes Num floats, either as they are or as two half floats per float
+static void WriteHalfs(float* Dest, const float* Src, uint32 Num, bool bHalf)
+{
+	if (!bHalf)
+	{
+		FMemory::Memcpy(Dest, Src, Num * sizeof(float));
+		return;
+	}
+
+	uint32* DestWords = reinterpret_cast<uint32*>(Dest);
+	for (uint32 i = 0; i + 1 < Num; i += 2)
+	{
+		DestWords[i / 2] = static_cast<uint32>(FFloat16(Src[i]).Encoded) | (static_cast<uint32>(FFloat16(Src[i + 1]).Encoded) << 16);
+	}
+	if (Num & 1)
+	{
+		DestWords[Num / 2] = FFloat16(Src[Num - 1]).Encoded;
+	}
+}
+
+bool FNTTTextBufferRegistry::PackCharacterRecords(const FNTTTextLayout& Layout, const FNTTGlyphTable& GlyphTable, TArray<FNTTCharacterRecord>& OutRecords)
+{
+	OutRecords.Reset();
+
+	// Line and word indices never exceed the character count, and 0xFFFF is kept free to encode INDEX_NONE
+	const int32 NumChars = Layout.Unicode.Num();
+	if (NumChars >= 0xFFFF)
+	{
+		return false;
+	}
+
+	const int32 NumGlyphs = GlyphTable.NumGlyphs();
+	OutRecords.SetNumUninitialized(NumChars);
+	for (int32 CharIdx = 0; CharIdx < NumChars; ++CharIdx)
+	{
+		FNTTCharacterRecord& Record = OutRecords[CharIdx];
+		Record.Position = Layout.CharacterPositions[CharIdx];
+		Record.LineAndWord = (static_cast<uint32>(Layout.CharacterLineIndices[CharIdx]) & 0xFFFF) | (static_cast<uint32>(Layout.CharacterWordIndices[CharIdx]) << 16);
+
+		const int32 GlyphIndex = Layout.GlyphIndices[CharIdx];
+		if (GlyphIndex >= 0 && GlyphIndex < NumGlyphs)
+		{
+			const FVector2f& Size = GlyphTable.CharacterSpriteSizes[GlyphIndex];
+			Record.SpriteSize = static_cast<uint32>(FFloat16(Size.X).Encoded) | (static_cast<uint32>(FFloat16(Size.Y).Encoded) << 16);
+			Record.UVs = GlyphTable.CharacterTextureUvs[GlyphIndex];
+		}
+		else
+		{
+			Record.SpriteSize = 0;
+			Record.UVs = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		}
+	}
+	return true;
+}
+
+TSharedRef<const FNTTPackedLayout, ESPMode::ThreadSafe> FNTTTextBufferRegistry::Pack(const FNTTTextLayout& Layout, const FNTTGlyphTable* GlyphTable)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NTTTextBufferRegistry_Pack);
+
+	const uint32 NumChars = (uint32)Layout.Unicode.Num();
+	const uint32 NumLines = (uint32)Layout.LineStartIndices.Num();
+	const uint32 NumWords = (uint32)Layout.WordStartIndices.Num();
+	const uint32 NumStyledChars = (uint32)Layout.CharacterColors.Num();
+	const uint32 NumRotatedChars = (uint32)Layout.CharacterRotations.Num();
+	const uint32 Flags = CVarNTTTextBufferCompact.GetValueOnAnyThread() != 0 ? GetCompactFlags(Layout) : 0;
+	const bool bCompactIndices = (Flags & Flag_CompactIndices) != 0;
+	const bool bHalfPositions = (Flags & Flag_HalfPositions) != 0;
+
+	TSharedRef<FNTTPackedLayout, ESPMode::ThreadSafe> Packed = MakeShared<FNTTPackedLayout, ESPMode::ThreadSafe>();
+	const FOffsets& Offsets = Packed->Offsets = GetOffsets(NumChars, NumLines, NumWords, NumStyledChars, NumRotatedChars, Flags);
+	Packed->Data.SetNumZeroed(FMath::Max(Offsets.TotalFloats, 1u));
+	float* DestInfo = Packed->Data.GetData();
+
+	// Uncompressed sections are already tightly packed ints/floats in the layout, so each is a single copy.
+	WriteIndices(&DestInfo[Offsets.GlyphIndices], Layout.GlyphIndices.GetData(), NumChars, bCompactIndices);
+	// A position's two components share one float when halved, so the pairs are packed the same way as a run of scales
+	WriteHalfs(&DestInfo[Offsets.Positions], reinterpret_cast<const float*>(Layout.CharacterPositions.GetData()), NumChars * 2, bHalfPositions);
+	WriteIndices(&DestInfo[Offsets.LineStart], Layout.LineStartIndices.GetData(), NumLines, bCompactIndices);
+	WriteIndices(&DestInfo[Offsets.LineCount], Layout.LineCharacterCounts.GetData(), NumLines, bCompactIndices);
+	WriteIndices(&DestInfo[Offsets.WordStart], Layout.WordStartIndices.GetData(), NumWords, bCompactIndices);
+	WriteIndices(&DestInfo[Offsets.WordCount], Layout.WordCharacterCounts.GetData(), NumWords, bCompactIndices);
+	WriteIndices(&DestInfo[Offsets.CharacterLines], Layout.CharacterLineIndices.GetData(), NumChars, bCompactIndices);
+	WriteIndices(&DestInfo[Offsets.CharacterWords], Layout.CharacterWordIndices.GetData(), NumChars, bCompactIndices);
+	WriteIndices(&DestInfo[Offsets.LinePrefixSums], Layout.LineCharacterPrefixSums.GetData(), Layout.LineCharacterPrefixSums.Num(), bCompactIndices);
+	WriteIndices(&DestInfo[Offsets.WordPrefixSums], Layout.WordCharacterPrefixSums.GetData(), Layout.WordCharacterPrefixSums.Num(), bCompactIndices);
+	WriteIndices(&DestInfo[Offsets.WordPrefixSumsWithWhitespace], Layout.WordCharacterPrefixSumsWithWhitespace.GetData(), Layout.WordCharacterPrefixSumsWithWhitespace.Num(), bCompactIndices);
+	FMemory::Memcpy(&DestInfo[Offsets.Colors], Layout.CharacterColors.GetData(), NumStyledChars * sizeof(FColor));
+	WriteHalfs(&DestInfo[Offsets.Scales], Layout.CharacterScales.GetData(), NumStyledChars, bHalfPositions);
+	WriteIndices(&DestInfo[Offsets.Styles], Layout.CharacterStyles.GetData(), NumStyledChars, bCompactIndices);
+	WriteHalfs(&DestInfo[Offsets.Rotations], Layout.CharacterRotations.GetData(), NumRotatedChars, bHalfPositions);
+	FMemory::Memcpy(&DestInfo[Offsets.LineWidths], Layout.LineWidths.GetData(), NumLines * sizeof(float));
+	for (uint32 LineIdx = 0; LineIdx < NumLines; ++LineIdx)
+	{
+		DestInfo[Offsets.LineTops + LineIdx] = Layout.LineTops[LineIdx] + Layout.BlockOffsetY;
+	}
+	FMemory::Memcpy(&DestInfo[Offsets.LineHeights], Layout.LineHeights.GetData(), NumLines * sizeof(float));
+	FMemory::Memcpy(&DestInfo[Offsets.WordBounds], Layout.WordBounds.GetData(), NumWords * sizeof(FVector4f));
+
+	if (GlyphTable && NumChars > 0 && CVarNTTTextBufferCharacterRecords.GetValueOnAnyThread() != 0)
+	{
+		PackCharacterRecords(Layout, *GlyphTable, Packed->Records);
+	}
+
+	return Packed;
+}
+
+FShaderResourceViewRHIRef FNTTTextBufferRegistry::AddRef(FRHICommandListBase& RHICmdList, const FNTTTextLayoutPtr& Layout, const FNTTGlyphTable* GlyphTable, FOffsets& OutOffsets, FShaderResourceViewRHIRef& OutRecordSRV)
+{
+	check(IsInRenderingThread());
+	check(Layout.IsValid());
+
+	FEntry& Entry = Entries.FindOrAdd(Layout.Get());
+	if (Entry.RefCount == 0)
+	{
+		// Layouts published by the data interface were packed on the game thread; anything else is packed here.
+		Entry.Layout = Layout;
+		Entry.Packed = Layout->Packed.IsValid() ? Layout->Packed : Pack(*Layout, GlyphTable);
+
+		const TArray<float>& Data = Entry.Packed->Data;
+		const uint32 NumBytes = Data.Num() * sizeof(float);
+		Entry.Buffer = FNTTBufferPool::Get().Acquire(RHICmdList, TEXT("NTT_TextBuffer"), sizeof(float), Data.Num());
+
+		void* DestInfo = RHICmdList.LockBuffer(Entry.Buffer.Buffer, 0, NumBytes, RLM_WriteOnly);
+		FMemory::Memcpy(DestInfo, Data.GetData(), NumBytes);
+		RHICmdList.UnlockBuffer(Entry.Buffer.Buffer);
+
+		const TArray<FNTTCharacterRecord>& Records = Entry.Packed->Records;
+		if (Records.Num() > 0)
+		{
+			// Two uint4 elements per record
+			const uint32 NumRecordBytes = Records.Num() * sizeof(FNTTCharacterRecord);
+			Entry.RecordBuffer = FNTTBufferPool::Get().Acquire(RHICmdList, TEXT("NTT_CharacterRecords"), sizeof(FUintVector4), Records.Num() * 2);
+
+			void* DestRecords = RHICmdList.LockBuffer(Entry.RecordBuffer.Buffer, 0, NumRecordBytes, RLM_WriteOnly);
+			FMemory::Memcpy(DestRecords, Records.GetData(), NumRecordBytes);
+			RHICmdList.UnlockBuffer(Entry.RecordBuffer.Buffer);
+		}
+
+		UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT Text Buffer (RT): Uploaded text buffer for layout %p (%d chars, %d lines, %d words, %u bytes, flags %u)"),
+			Layout.Get(), Layout->Unicode.Num(), Layout->LineStartIndices.Num(), Layout->WordStartIndices.Num(), NumBytes, Entry.Packed->Offsets.Flags);
+	}
+
+	++Entry.RefCount;
+	OutOffsets = Entry.Packed->Offsets;
+	OutRecordSRV = Entry.RecordBuffer.SRV;
+	return Entry.Buffer.SRV;
+}
+
+void FNTTTextBufferRegistry::Release(const FNTTTextLayoutPtr& Layout)
+{
+	check(IsInRenderingThread());
+
+	if (FEntry* Entry = Entries.Find(Layout.Get()))
+	{
+		if (--Entry->RefCount <= 0)
+		{
+			FNTTBufferPool::Get().Release(Entry->Buffer);
+			FNTTBufferPool::Get().Release(Entry->RecordBuffer);
+			Entries.Remove(Layout.Get());
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+// Checks every character record against the layout and glyph table it was packed from. Usage: NTT.ValidateCharacterRecords
+static FAutoConsoleCommand GNTTValidateCharacterRecordsCommand(
+	TEXT("NTT.ValidateCharacterRecords"),
+	TEXT("Packs generated NTT text layouts into character records and checks each record against the layout and glyph tables it was built from."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		// Synthetic printable-ASCII font so the check doesn't depend on content. Characters outside it have no glyph.
+		FNTTGlyphTable GlyphTable;
+		for (int32 Codepoint = ' '; Codepoint <= '~'; ++Codepoint)
+		{
+			GlyphTable.AddGlyph(Codepoint, FVector4f(0.01f * (Codepoint % 9), 0.02f, 0.001f * Codepoint, 0.5f), FVector2f(8.0f + (Codepoint % 7) * 0.37f, 16.0f), Codepoint % 3, 0);
+		}
+
+		FNTTTextLayoutSettings PlainSettings;
+		FNTTTextLayoutSettings WrappedSettings;
+		WrappedSettings.MaxLineWidth = 120.0f;
+		FNTTTextLayoutSettings MarkupSettings;
+		MarkupSettings.bParseMarkup = true;
+
+		struct FCase
+		{
+			const TCHAR* Text;
+			const FNTTTextLayoutSettings* Settings;
+		};
+		const FCase Cases[] = {
+			{ TEXT("Hello world"), &PlainSettings },
+			{ TEXT("  Leading spaces\nSecond line\n\nAfter an empty line  "), &PlainSettings },
+			{ TEXT("Wrapped text that is much wider than the maximum line width of the layout"), &WrappedSettings },
+			{ TEXT("<c=#FF0000>Red</c> and <s=2>big</s> words"), &MarkupSettings },
+			{ TEXT("Missing \x4E00\x4E01 glyphs \x0410"), &PlainSettings },
+		};
+
+		int32 NumMismatches = 0;
+		int32 NumRecords = 0;
+		FNTTTextLayout Layout;
+		TArray<FNTTCharacterRecord> Records;
+		for (const FCase& Case : Cases)
+		{
+			FNTTTextLayoutEngine::Layout(GlyphTable, *Case.Settings, Case.Text, Layout);
+			if (!FNTTTextBufferRegistry::PackCharacterRecords(Layout, GlyphTable, Records) || Records.Num() != Layout.Unicode.Num())
+			{
+				UE_LOG(LogNiagaraTextToolkit, Error, TEXT("NTT.ValidateCharacterRecords: '%s' packed %d records for %d characters"), Case.Text, Records.Num(), Layout.Unicode.Num());
+				++NumMismatches;
+				continue;
+			}
+
+			for (int32 CharIdx = 0; CharIdx < Records.Num(); ++CharIdx)
+			{
+				const FNTTCharacterRecord& Record = Records[CharIdx];
+				const int32 GlyphIndex = Layout.GlyphIndices[CharIdx];
+				const bool bHasGlyph = GlyphIndex >= 0 && GlyphIndex < GlyphTable.NumGlyphs();
+				const FVector2f ExpectedSize = bHasGlyph ? GlyphTable.CharacterSpriteSizes[GlyphIndex] : FVector2f(0.0f, 0.0f);
+				const FVector4f ExpectedUVs = bHasGlyph ? GlyphTable.CharacterTextureUvs[GlyphIndex] : FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+
+				// Decoded the same way as ReadCharacterRecord_ in NTTDataInterface.ush
+				FFloat16 Width;
+				FFloat16 Height;
+				Width.Encoded = static_cast<uint16>(Record.SpriteSize & 0xFFFF);
+				Height.Encoded = static_cast<uint16>(Record.SpriteSize >> 16);
+				const int32 LineIndex = static_cast<int32>(Record.LineAndWord & 0xFFFF);
+				const uint32 Word = Record.LineAndWord >> 16;
+				const int32 WordIndex = Word == 0xFFFF ? INDEX_NONE : static_cast<int32>(Word);
+
+				// Sprite sizes are halves, so they only have to match to half precision
+				const bool bMatches = Record.Position == Layout.CharacterPositions[CharIdx]
+					&& FMath::IsNearlyEqual(Width.GetFloat(), ExpectedSize.X, FMath::Abs(ExpectedSize.X) * 1e-3f)
+					&& FMath::IsNearlyEqual(Height.GetFloat(), ExpectedSize.Y, FMath::Abs(ExpectedSize.Y) * 1e-3f)
+					&& Record.UVs == ExpectedUVs
+					&& LineIndex == Layout.CharacterLineIndices[CharIdx]
+					&& WordIndex == Layout.CharacterWordIndices[CharIdx];
+				if (!bMatches)
+				{
+					UE_LOG(LogNiagaraTextToolkit, Error, TEXT("NTT.ValidateCharacterRecords: '%s' character %d doesn't match its layout (line %d/%d, word %d/%d)"),
+						Case.Text, CharIdx, LineIndex, Layout.CharacterLineIndices[CharIdx], WordIndex, Layout.CharacterWordIndices[CharIdx]);
+					++NumMismatches;
+				}
+			}
+			NumRecords += Records.Num();
+		}
+
+		UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT.ValidateCharacterRecords: %d records checked, %d mismatches"), NumRecords, NumMismatches);
+	}));
+
+#endif
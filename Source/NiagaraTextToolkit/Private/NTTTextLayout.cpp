@@ -0,0 +1,1477 @@
+// Property of Lucian Tranc
+
+#include "NTTTextLayout.h"
+#include "NTTDataInterface.h"
+#include "NTTTextBufferRegistry.h"
+#include "NTTCompat.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeLock.h"
+
+static bool IsWhitespaceChar(int32 Code)
+{
+	return Code == ' '
+		|| Code == '\t';
+}
+
+// Vertical alignment: where the top of a block of text TotalHeight tall is placed relative to Y=0.
+static float GetBlockOffsetY(ENTTTextVerticalAlignment VerticalAlignment, float TotalHeight)
+{
+	switch (VerticalAlignment)
+	{
+		case ENTTTextVerticalAlignment::NTT_TVA_Top:
+		{
+			// Top of first line at Y=0.
+			return 0.0f;
+		}
+		case ENTTTextVerticalAlignment::NTT_TVA_Center:
+		{
+			// Center of the whole block at Y=0.
+			return -(TotalHeight * 0.5f);
+		}
+		case ENTTTextVerticalAlignment::NTT_TVA_Bottom:
+		{
+			// Bottom of the last line at Y=0.
+			return -TotalHeight;
+		}
+		default:
+		{
+			return 0.0f;
+		}
+	}
+}
+
+// Horizontal alignment: where the left edge of a line Width wide is placed relative to X=0.
+static float GetLineStartX(ENTTTextHorizontalAlignment HorizontalAlignment, float Width)
+{
+	switch (HorizontalAlignment)
+	{
+		case ENTTTextHorizontalAlignment::NTT_THA_Left:
+		{
+			return 0.0f;
+		}
+		case ENTTTextHorizontalAlignment::NTT_THA_Center:
+		{
+			return -Width * 0.5f;
+		}
+		case ENTTTextHorizontalAlignment::NTT_THA_Right:
+		{
+			return -Width;
+		}
+		default:
+		{
+			return 0.0f;
+		}
+	}
+}
+
+void FNTTTextLayout::Reset()
+{
+	Unicode.Reset();
+	GlyphIndices.Reset();
+	CharacterPositions.Reset();
+	LineStartIndices.Reset();
+	LineCharacterCounts.Reset();
+	WordStartIndices.Reset();
+	WordCharacterCounts.Reset();
+	TotalTextHeight = 0.0f;
+	CharacterLineIndices.Reset();
+	LineCharacterPrefixSums.Reset();
+	WordCharacterPrefixSums.Reset();
+	WordCharacterPrefixSumsWithWhitespace.Reset();
+	CharacterWordIndices.Reset();
+	CharacterColors.Reset();
+	CharacterScales.Reset();
+	CharacterStyles.Reset();
+	CharacterRotations.Reset();
+	LineSourceStartIndices.Reset();
+	LineWidths.Reset();
+	LineTops.Reset();
+	LineHeights.Reset();
+	WordBounds.Reset();
+	TextBounds = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+	Packed.Reset();
+	BlockOffsetY = 0.0f;
+	SourceText.Reset();
+}
+
+SIZE_T FNTTTextLayout::GetAllocatedSize() const
+{
+	return Unicode.GetAllocatedSize()
+		+ GlyphIndices.GetAllocatedSize()
+		+ CharacterPositions.GetAllocatedSize()
+		+ LineStartIndices.GetAllocatedSize()
+		+ LineCharacterCounts.GetAllocatedSize()
+		+ WordStartIndices.GetAllocatedSize()
+		+ WordCharacterCounts.GetAllocatedSize()
+		+ CharacterLineIndices.GetAllocatedSize()
+		+ LineCharacterPrefixSums.GetAllocatedSize()
+		+ WordCharacterPrefixSums.GetAllocatedSize()
+		+ WordCharacterPrefixSumsWithWhitespace.GetAllocatedSize()
+		+ CharacterWordIndices.GetAllocatedSize()
+		+ CharacterColors.GetAllocatedSize()
+		+ CharacterScales.GetAllocatedSize()
+		+ CharacterStyles.GetAllocatedSize()
+		+ CharacterRotations.GetAllocatedSize()
+		+ LineSourceStartIndices.GetAllocatedSize()
+		+ LineWidths.GetAllocatedSize()
+		+ LineTops.GetAllocatedSize()
+		+ LineHeights.GetAllocatedSize()
+		+ WordBounds.GetAllocatedSize()
+		+ SourceText.GetAllocatedSize()
+		+ (Packed.IsValid() ? Packed->Data.GetAllocatedSize() + Packed->Records.GetAllocatedSize() : 0);
+}
+
+static int32 GNTTLayoutVectorized = 1;
+static FAutoConsoleVariableRef CVarNTTLayoutVectorized(
+	TEXT("NTT.Layout.Vectorized"),
+	GNTTLayoutVectorized,
+	TEXT("1 resolves character X positions with a SIMD prefix sum, 0 with the scalar loop. Lines with word wrapping always use the scalar scan."),
+	ECVF_Default);
+
+// Resolves the X positions of one line. Steps[i] is how far character i moves the pen (kerning, filtered whitespace before it and its own width),
+// and HalfWidths[i] is half its width, or negative for characters with no glyph, which stay at X=0.
+// Writes each drawn character's center X, relative to the line's left edge, and returns the pen position after the last character.
+static float AccumulateLineX_Scalar(const float* Steps, const float* HalfWidths, int32 Num, FVector2f* OutPositions)
+{
+	float PenX = 0.0f;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		PenX += Steps[Index];
+		OutPositions[Index].X = HalfWidths[Index] >= 0.0f ? PenX - HalfWidths[Index] : 0.0f;
+	}
+	return PenX;
+}
+
+static float AccumulateLineX_Vectorized(const float* Steps, const float* HalfWidths, int32 Num, FVector2f* OutPositions)
+{
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float ZeroFirstLane = MakeVectorRegisterFloat(0.0f, 1.0f, 1.0f, 1.0f);
+
+	// Pen position after the previous group of four, in every lane
+	VectorRegister4Float Carry = Zero;
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		// Inclusive prefix sum within the register: add the steps shifted up by one lane, then the result shifted up by two.
+		VectorRegister4Float PenX = VectorLoad(Steps + Index);
+		PenX = VectorAdd(PenX, VectorMultiply(VectorSwizzle(PenX, 0, 0, 1, 2), ZeroFirstLane));
+		PenX = VectorAdd(PenX, VectorShuffle(Zero, PenX, 0, 0, 0, 1));
+		PenX = VectorAdd(PenX, Carry);
+		Carry = VectorReplicate(PenX, 3);
+
+		const VectorRegister4Float Half = VectorLoad(HalfWidths + Index);
+		const VectorRegister4Float CenterX = VectorSelect(VectorCompareGE(Half, Zero), VectorSubtract(PenX, Half), Zero);
+
+		alignas(16) float CenterXs[4];
+		VectorStoreAligned(CenterX, CenterXs);
+		OutPositions[Index + 0].X = CenterXs[0];
+		OutPositions[Index + 1].X = CenterXs[1];
+		OutPositions[Index + 2].X = CenterXs[2];
+		OutPositions[Index + 3].X = CenterXs[3];
+	}
+
+	float PenX = VectorGetComponent(Carry, 0);
+	for (; Index < Num; ++Index)
+	{
+		PenX += Steps[Index];
+		OutPositions[Index].X = HalfWidths[Index] >= 0.0f ? PenX - HalfWidths[Index] : 0.0f;
+	}
+	return PenX;
+}
+
+static float AccumulateLineX(const float* Steps, const float* HalfWidths, int32 Num, FVector2f* OutPositions)
+{
+	return GNTTLayoutVectorized
+		? AccumulateLineX_Vectorized(Steps, HalfWidths, Num, OutPositions)
+		: AccumulateLineX_Scalar(Steps, HalfWidths, Num, OutPositions);
+}
+
+// Style state while scanning markup. Tags nest, so each kind keeps a stack and a closing tag restores the value from before its opening tag.
+struct FNTTMarkupState
+{
+	TArray<FColor, TInlineAllocator<4>> Colors;
+	TArray<float, TInlineAllocator<4>> Scales;
+	TArray<int32, TInlineAllocator<4>> Styles;
+
+	FColor GetColor() const { return Colors.Num() > 0 ? Colors.Last() : FColor::White; }
+	float GetScale() const { return Scales.Num() > 0 ? Scales.Last() : 1.0f; }
+	int32 GetStyle() const { return Styles.Num() > 0 ? Styles.Last() : INDEX_NONE; }
+};
+
+// Parses #RRGGBB or #RRGGBBAA.
+static bool ParseMarkupColor(FStringView Value, FColor& OutColor)
+{
+	if (Value.StartsWith(TEXT('#')))
+	{
+		Value.RightChopInline(1);
+	}
+	if (Value.Len() != 6 && Value.Len() != 8)
+	{
+		return false;
+	}
+
+	uint32 Bits = 0;
+	for (const TCHAR Ch : Value)
+	{
+		if (!FChar::IsHexDigit(Ch))
+		{
+			return false;
+		}
+		Bits = (Bits << 4) | static_cast<uint32>(FParse::HexDigit(Ch));
+	}
+	if (Value.Len() == 6)
+	{
+		Bits = (Bits << 8) | 0xFF;
+	}
+
+	OutColor = FColor(uint8(Bits >> 24), uint8(Bits >> 16), uint8(Bits >> 8), uint8(Bits));
+	return true;
+}
+
+// Parses a positive decimal scale such as 1.5.
+static bool ParseMarkupScale(FStringView Value, float& OutScale)
+{
+	TCHAR Buffer[16];
+	if (Value.Len() == 0 || Value.Len() >= UE_ARRAY_COUNT(Buffer))
+	{
+		return false;
+	}
+	for (const TCHAR Ch : Value)
+	{
+		if (!FChar::IsDigit(Ch) && Ch != '.')
+		{
+			return false;
+		}
+	}
+
+	FMemory::Memcpy(Buffer, Value.GetData(), Value.Len() * sizeof(TCHAR));
+	Buffer[Value.Len()] = 0;
+	OutScale = FCString::Atof(Buffer);
+	return OutScale > 0.0f;
+}
+
+// If the text at Index is a markup tag, applies it to State and returns its length. Returns 0 for anything else, which is then laid out as text.
+static int32 ParseMarkupTag(const TCHAR* Text, int32 Index, int32 TextLength, const FNTTTextLayoutSettings& Settings, FNTTMarkupState& State)
+{
+	// Tags are short and never span lines, which bounds the search for the closing bracket.
+	static constexpr int32 MaxTagLength = 64;
+	const int32 SearchEnd = FMath::Min(TextLength, Index + MaxTagLength);
+	int32 CloseIndex = Index + 1;
+	while (CloseIndex < SearchEnd && Text[CloseIndex] != '>' && Text[CloseIndex] != '<' && Text[CloseIndex] != '\n' && Text[CloseIndex] != '\r')
+	{
+		++CloseIndex;
+	}
+	if (CloseIndex >= SearchEnd || Text[CloseIndex] != '>')
+	{
+		return 0;
+	}
+
+	const FStringView Tag(Text + Index + 1, CloseIndex - Index - 1);
+	const int32 TagLength = CloseIndex - Index + 1;
+
+	if (Tag.StartsWith(TEXT('/')))
+	{
+		const FStringView Name = Tag.RightChop(1);
+		if (Name.Equals(TEXT("c"), ESearchCase::IgnoreCase))
+		{
+			if (State.Colors.Num() > 0)
+			{
+				State.Colors.Pop(NTT_NO_SHRINK);
+			}
+		}
+		else if (Name.Equals(TEXT("s"), ESearchCase::IgnoreCase))
+		{
+			if (State.Scales.Num() > 0)
+			{
+				State.Scales.Pop(NTT_NO_SHRINK);
+			}
+		}
+		else if (Name.Equals(TEXT("style"), ESearchCase::IgnoreCase))
+		{
+			if (State.Styles.Num() > 0)
+			{
+				State.Styles.Pop(NTT_NO_SHRINK);
+			}
+		}
+		else
+		{
+			return 0;
+		}
+		return TagLength;
+	}
+
+	int32 EqualsIndex = INDEX_NONE;
+	if (!Tag.FindChar(TEXT('='), EqualsIndex))
+	{
+		return 0;
+	}
+	const FStringView Name = Tag.Left(EqualsIndex);
+	const FStringView Value = Tag.RightChop(EqualsIndex + 1);
+
+	if (Name.Equals(TEXT("c"), ESearchCase::IgnoreCase))
+	{
+		FColor Color;
+		if (!ParseMarkupColor(Value, Color))
+		{
+			return 0;
+		}
+		State.Colors.Push(Color);
+	}
+	else if (Name.Equals(TEXT("s"), ESearchCase::IgnoreCase))
+	{
+		float Scale = 1.0f;
+		if (!ParseMarkupScale(Value, Scale))
+		{
+			return 0;
+		}
+		State.Scales.Push(Scale);
+	}
+	else if (Name.Equals(TEXT("style"), ESearchCase::IgnoreCase))
+	{
+		// Unknown style names are still consumed as markup, they just don't map to a style.
+		const FName StyleName(Value.Len(), Value.GetData(), FNAME_Find);
+		State.Styles.Push(StyleName.IsNone() ? INDEX_NONE : Settings.MarkupStyles.IndexOfByKey(StyleName));
+	}
+	else
+	{
+		return 0;
+	}
+	return TagLength;
+}
+
+// Fills the per-character line and word indices from FirstCharacter on, from the finished line and word tables
+static void BuildCharacterIndices(FNTTTextLayout& Layout, int32 FirstCharacter)
+{
+	const int32 NumChars = Layout.Unicode.Num();
+	Layout.CharacterLineIndices.SetNumUninitialized(NumChars, NTT_NO_SHRINK);
+	Layout.CharacterWordIndices.SetNumUninitialized(NumChars, NTT_NO_SHRINK);
+
+	// Lines cover the characters back to back
+	const int32 NumLines = Layout.LineStartIndices.Num();
+	for (int32 LineIdx = FMath::Max(Algo::UpperBound(Layout.LineStartIndices, FirstCharacter) - 1, 0); LineIdx < NumLines; ++LineIdx)
+	{
+		const int32 LineStart = FMath::Max(Layout.LineStartIndices[LineIdx], FirstCharacter);
+		const int32 LineEnd = Layout.LineStartIndices[LineIdx] + Layout.LineCharacterCounts[LineIdx];
+		for (int32 CharIdx = LineStart; CharIdx < LineEnd; ++CharIdx)
+		{
+			Layout.CharacterLineIndices[CharIdx] = LineIdx;
+		}
+	}
+
+	// Each word runs up to the start of the next one, taking any whitespace after it along
+	const int32 NumWords = Layout.WordStartIndices.Num();
+	int32 WordIdx = Algo::UpperBound(Layout.WordStartIndices, FirstCharacter) - 1;
+	int32 CharIdx = FirstCharacter;
+	if (WordIdx < 0)
+	{
+		const int32 FirstWordStart = NumWords > 0 ? Layout.WordStartIndices[0] : NumChars;
+		for (; CharIdx < FirstWordStart; ++CharIdx)
+		{
+			Layout.CharacterWordIndices[CharIdx] = INDEX_NONE;
+		}
+		WordIdx = 0;
+	}
+	for (; WordIdx < NumWords; ++WordIdx)
+	{
+		const int32 WordEnd = WordIdx + 1 < NumWords ? Layout.WordStartIndices[WordIdx + 1] : NumChars;
+		for (; CharIdx < WordEnd; ++CharIdx)
+		{
+			Layout.CharacterWordIndices[CharIdx] = WordIdx;
+		}
+	}
+}
+
+// Rebuilds the line and word prefix sums. They're one entry per line or word, far fewer than characters, so they're always rebuilt in full.
+static void BuildPrefixSums(FNTTTextLayout& Layout)
+{
+	const int32 NumLines = Layout.LineCharacterCounts.Num();
+	Layout.LineCharacterPrefixSums.SetNumUninitialized(NumLines + 1, NTT_NO_SHRINK);
+	Layout.LineCharacterPrefixSums[0] = 0;
+	for (int32 LineIdx = 0; LineIdx < NumLines; ++LineIdx)
+	{
+		Layout.LineCharacterPrefixSums[LineIdx + 1] = Layout.LineCharacterPrefixSums[LineIdx] + Layout.LineCharacterCounts[LineIdx];
+	}
+
+	// A word's trailing whitespace runs up to the next word's start, or the end of the text for the last word.
+	const int32 NumWords = Layout.WordCharacterCounts.Num();
+	const int32 NumChars = Layout.Unicode.Num();
+	Layout.WordCharacterPrefixSums.SetNumUninitialized(NumWords + 1, NTT_NO_SHRINK);
+	Layout.WordCharacterPrefixSumsWithWhitespace.SetNumUninitialized(NumWords + 1, NTT_NO_SHRINK);
+	Layout.WordCharacterPrefixSums[0] = 0;
+	Layout.WordCharacterPrefixSumsWithWhitespace[0] = 0;
+	for (int32 WordIdx = 0; WordIdx < NumWords; ++WordIdx)
+	{
+		const int32 WordCount = Layout.WordCharacterCounts[WordIdx];
+		const int32 WordEnd = Layout.WordStartIndices[WordIdx] + WordCount;
+		const int32 NextWordStart = WordIdx + 1 < NumWords ? Layout.WordStartIndices[WordIdx + 1] : NumChars;
+		Layout.WordCharacterPrefixSums[WordIdx + 1] = Layout.WordCharacterPrefixSums[WordIdx] + WordCount;
+		Layout.WordCharacterPrefixSumsWithWhitespace[WordIdx + 1] = Layout.WordCharacterPrefixSumsWithWhitespace[WordIdx] + WordCount + FMath::Max(0, NextWordStart - WordEnd);
+	}
+}
+
+// Rebuilds the word boxes from FirstWord on, moving the kept ones by KeptDeltaY, then the text box from all of them.
+// GetSize returns the drawn size of a character that has a glyph.
+template <typename GetSizeType>
+static void BuildBounds(FNTTTextLayout& Layout, int32 FirstWord, float KeptDeltaY, GetSizeType&& GetSize)
+{
+	if (KeptDeltaY != 0.0f)
+	{
+		for (int32 WordIdx = 0; WordIdx < FirstWord; ++WordIdx)
+		{
+			FVector4f& Bounds = Layout.WordBounds[WordIdx];
+			if (Bounds.X < Bounds.Z)
+			{
+				Bounds.Y += KeptDeltaY;
+				Bounds.W += KeptDeltaY;
+			}
+		}
+	}
+
+	const int32 NumWords = Layout.WordStartIndices.Num();
+	Layout.WordBounds.SetNumUninitialized(NumWords, NTT_NO_SHRINK);
+	for (int32 WordIdx = FirstWord; WordIdx < NumWords; ++WordIdx)
+	{
+		FVector4f Bounds(MAX_flt, MAX_flt, -MAX_flt, -MAX_flt);
+		const int32 WordStart = Layout.WordStartIndices[WordIdx];
+		const int32 WordEnd = WordStart + Layout.WordCharacterCounts[WordIdx];
+		for (int32 CharIdx = WordStart; CharIdx < WordEnd; ++CharIdx)
+		{
+			if (Layout.GlyphIndices[CharIdx] != INDEX_NONE)
+			{
+				const FVector2f HalfSize = GetSize(CharIdx) * 0.5f;
+				const FVector2f& Position = Layout.CharacterPositions[CharIdx];
+				Bounds.X = FMath::Min(Bounds.X, Position.X - HalfSize.X);
+				Bounds.Y = FMath::Min(Bounds.Y, Position.Y - HalfSize.Y);
+				Bounds.Z = FMath::Max(Bounds.Z, Position.X + HalfSize.X);
+				Bounds.W = FMath::Max(Bounds.W, Position.Y + HalfSize.Y);
+			}
+		}
+		Layout.WordBounds[WordIdx] = Bounds.X <= Bounds.Z ? Bounds : FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+	}
+
+	FVector4f TextBounds(MAX_flt, MAX_flt, -MAX_flt, -MAX_flt);
+	for (const FVector4f& Bounds : Layout.WordBounds)
+	{
+		if (Bounds.X < Bounds.Z)
+		{
+			TextBounds.X = FMath::Min(TextBounds.X, Bounds.X);
+			TextBounds.Y = FMath::Min(TextBounds.Y, Bounds.Y);
+			TextBounds.Z = FMath::Max(TextBounds.Z, Bounds.Z);
+			TextBounds.W = FMath::Max(TextBounds.W, Bounds.W);
+		}
+	}
+	Layout.TextBounds = TextBounds.X <= TextBounds.Z ? TextBounds : FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+// Bends the laid out text along the arc or path in Settings, moving every drawn character onto it and recording its rotation.
+// Layout X becomes the distance along the curve and layout Y the distance off it, so line spacing and alignment carry over.
+static void ApplyTextPath(const FNTTTextLayoutSettings& Settings, FNTTTextLayout& Layout)
+{
+	const int32 NumChars = Layout.CharacterPositions.Num();
+	Layout.CharacterRotations.SetNumZeroed(NumChars, NTT_NO_SHRINK);
+
+	if (Settings.PathMode == ENTTTextPathMode::NTT_TPM_Arc)
+	{
+		// A zero radius would put every character on the center, so the text is left straight
+		const float Radius = Settings.ArcRadius;
+		if (Radius == 0.0f)
+		{
+			return;
+		}
+
+		// The text origin sits on top of the circle (for a positive radius) before the start angle is applied
+		const FVector2f Center(0.0f, Radius);
+		const float StartAngle = FMath::DegreesToRadians(Settings.ArcStartAngle);
+		for (int32 CharIdx = 0; CharIdx < NumChars; ++CharIdx)
+		{
+			if (Layout.GlyphIndices[CharIdx] == INDEX_NONE)
+			{
+				continue;
+			}
+
+			FVector2f& Position = Layout.CharacterPositions[CharIdx];
+			const float Angle = StartAngle + Position.X / Radius;
+			float Sin, Cos;
+			FMath::SinCos(&Sin, &Cos, Angle);
+			Position = Center + FVector2f(Sin, -Cos) * (Radius - Position.Y);
+			Layout.CharacterRotations[CharIdx] = Angle;
+		}
+		return;
+	}
+
+	const TArray<FVector2f>& Points = Settings.PathPoints;
+	if (Settings.PathMode != ENTTTextPathMode::NTT_TPM_Path || Points.Num() < 2)
+	{
+		return;
+	}
+
+	// Distance along the path at each point, and each segment's direction. Repeated points reuse the previous direction.
+	const int32 NumSegments = Points.Num() - 1;
+	TArray<float, TInlineAllocator<64>> Distances;
+	TArray<FVector2f, TInlineAllocator<64>> Tangents;
+	Distances.SetNumUninitialized(Points.Num());
+	Tangents.SetNumUninitialized(NumSegments);
+	Distances[0] = 0.0f;
+	FVector2f PreviousTangent(1.0f, 0.0f);
+	for (int32 SegmentIdx = 0; SegmentIdx < NumSegments; ++SegmentIdx)
+	{
+		const FVector2f Delta = Points[SegmentIdx + 1] - Points[SegmentIdx];
+		const float SegmentLength = Delta.Size();
+		Distances[SegmentIdx + 1] = Distances[SegmentIdx] + SegmentLength;
+		Tangents[SegmentIdx] = SegmentLength > UE_KINDA_SMALL_NUMBER ? Delta / SegmentLength : PreviousTangent;
+		PreviousTangent = Tangents[SegmentIdx];
+	}
+
+	const float PathLength = Distances.Last();
+	const float Anchor = Settings.HorizontalAlignment == ENTTTextHorizontalAlignment::NTT_THA_Left ? 0.0f
+		: Settings.HorizontalAlignment == ENTTTextHorizontalAlignment::NTT_THA_Center ? PathLength * 0.5f
+		: PathLength;
+
+	for (int32 CharIdx = 0; CharIdx < NumChars; ++CharIdx)
+	{
+		if (Layout.GlyphIndices[CharIdx] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		// Characters past either end carry on along the end segments
+		FVector2f& Position = Layout.CharacterPositions[CharIdx];
+		const float Distance = Anchor + Position.X;
+		const int32 SegmentIdx = FMath::Clamp(Algo::UpperBound(Distances, Distance) - 1, 0, NumSegments - 1);
+		const FVector2f& Tangent = Tangents[SegmentIdx];
+		const FVector2f Normal(-Tangent.Y, Tangent.X);
+		Position = Points[SegmentIdx] + Tangent * (Distance - Distances[SegmentIdx]) + Normal * Position.Y;
+		Layout.CharacterRotations[CharIdx] = FMath::Atan2(Tangent.Y, Tangent.X);
+	}
+}
+
+// Layouts whose last reference went away, kept with their allocations so the next layout can be built without touching the heap.
+struct FNTTTextLayoutPool
+{
+	static constexpr int32 MaxPooledLayouts = 32;
+
+	FCriticalSection Lock;
+	TArray<FNTTTextLayout> Layouts;
+
+	static FNTTTextLayoutPool& Get()
+	{
+		static FNTTTextLayoutPool Instance;
+		return Instance;
+	}
+};
+
+// Returns Layout's allocations to the pool, or frees them if the pool is full.
+static void ReleaseLayout(FNTTTextLayout* Layout)
+{
+	// Nothing worth keeping if the layout never allocated.
+	if (Layout->Unicode.Max() > 0)
+	{
+		Layout->Reset();
+
+		FNTTTextLayoutPool& Pool = FNTTTextLayoutPool::Get();
+		FScopeLock Lock(&Pool.Lock);
+		if (Pool.Layouts.Num() < FNTTTextLayoutPool::MaxPooledLayouts)
+		{
+			Pool.Layouts.Reserve(FNTTTextLayoutPool::MaxPooledLayouts);
+			Pool.Layouts.Add(MoveTemp(*Layout));
+		}
+	}
+
+	delete Layout;
+}
+
+TSharedRef<FNTTTextLayout, ESPMode::ThreadSafe> FNTTTextLayoutEngine::AllocateLayout()
+{
+	FNTTTextLayout* Layout = new FNTTTextLayout();
+	{
+		FNTTTextLayoutPool& Pool = FNTTTextLayoutPool::Get();
+		FScopeLock Lock(&Pool.Lock);
+		if (Pool.Layouts.Num() > 0)
+		{
+			*Layout = Pool.Layouts.Pop(NTT_NO_SHRINK);
+		}
+	}
+	return MakeShareable(Layout, &ReleaseLayout);
+}
+
+// Lays out InputText starting at FirstLine. Lines before FirstLine must already be laid out from the same prefix of InputText with the same
+// glyph table and settings; they are kept as they are apart from picking up any change in vertical alignment.
+static void LayoutFromLine(const FNTTGlyphTable& GlyphTable, const FNTTTextLayoutSettings& Settings, const FString& InputText, int32 FirstLine, FNTTTextLayout& Layout)
+{
+	const int32 TextLength = InputText.Len();
+
+	// Without glyph data there is nothing to lay out.
+	if (TextLength > 0 && GlyphTable.NumGlyphs() == 0)
+	{
+		Layout.Reset();
+		return;
+	}
+
+	const int32 FirstOutputIndex = FirstLine > 0 ? Layout.LineStartIndices[FirstLine] : 0;
+	const int32 FirstSourceIndex = FirstLine > 0 ? Layout.LineSourceStartIndices[FirstLine] : 0;
+	const float PreviousBlockOffsetY = Layout.BlockOffsetY;
+	// tops are aligned at 0, so the top of the first line is at 0, and the top of the second line is the height of the first line, etc.
+	float TotalHeight = FirstLine > 0 ? Layout.LineTops[FirstLine] : 0.0f;
+
+	// Drop everything from the first relaid line onward. Words never cross lines, so the words that start before the line are exactly the words of the kept lines.
+	const int32 FirstWordIndex = FirstLine > 0 ? Algo::LowerBound(Layout.WordStartIndices, FirstOutputIndex) : 0;
+	Layout.Unicode.SetNum(FirstOutputIndex, NTT_NO_SHRINK);
+	Layout.GlyphIndices.SetNum(FirstOutputIndex, NTT_NO_SHRINK);
+	Layout.CharacterPositions.SetNum(FirstOutputIndex, NTT_NO_SHRINK);
+	Layout.WordStartIndices.SetNum(FirstWordIndex, NTT_NO_SHRINK);
+	Layout.WordCharacterCounts.SetNum(FirstWordIndex, NTT_NO_SHRINK);
+	Layout.LineStartIndices.SetNum(FirstLine, NTT_NO_SHRINK);
+	Layout.LineSourceStartIndices.SetNum(FirstLine, NTT_NO_SHRINK);
+	Layout.LineCharacterCounts.SetNum(FirstLine, NTT_NO_SHRINK);
+	Layout.LineWidths.SetNum(FirstLine, NTT_NO_SHRINK);
+	Layout.LineTops.SetNum(FirstLine, NTT_NO_SHRINK);
+	Layout.LineHeights.SetNum(FirstLine, NTT_NO_SHRINK);
+
+	const TCHAR* Text = *InputText;
+	const float CharIncrement = static_cast<float>(GlyphTable.Kerning) + Settings.KerningOffset;
+
+	Layout.Unicode.Reserve(TextLength);
+	Layout.GlyphIndices.Reserve(TextLength);
+	Layout.CharacterPositions.Reserve(TextLength);
+
+	// Current line state. Positions are written relative to the line's left edge and top, and fixed up once the line metrics are known.
+	float LineX = 0.0f;
+	float MaxBottom = 0.0f;
+	// True if the previous character in this line was drawn, meaning kerning applies before the next non-whitespace character.
+	bool bPendingKerning = false;
+	// A line is open until its newline is consumed; a trailing newline does not start a new line.
+	bool bLineOpen = FirstSourceIndex < TextLength;
+
+	// Current word state
+	bool bInsideWord = false;
+	int32 CurrentWordStartIndex = -1;
+	int32 CurrentWordCharCount = 0;
+
+	// Word wrap state. A word that would cross MaxLineWidth is moved to a new line, unless it is the first word on its line.
+	const bool bWrap = Settings.MaxLineWidth > 0.0f;
+	// Right edge of the last non-whitespace glyph on the line, so wrapped lines don't count their trailing whitespace
+	float ContentEndX = 0.0f;
+	bool bLineHasWord = false;
+	bool bWordCanWrap = false;
+	int32 CurrentWordSourceIndex = 0;
+	float WordStartX = 0.0f;
+	float WordMaxBottom = 0.0f;
+	float LineWidthBeforeWord = 0.0f;
+	float MaxBottomBeforeWord = 0.0f;
+
+	// Without wrapping nothing in the scan needs the pen position, so the scan only records how far each output character moves the pen
+	// and the line's X positions are resolved when it ends by a prefix sum (AccumulateLineX). That keeps the serial float add chain out of the scan.
+	// With wrapping the pen is tracked directly, as the wrap decision needs it.
+	const bool bDeferX = !bWrap;
+	// Pen movement since the last output character: kerning, filtered whitespace and the character's own width
+	float PendingAdvance = 0.0f;
+	float& PenX = bDeferX ? PendingAdvance : LineX;
+	TArray<float, TInlineAllocator<256>> LineSteps;
+	TArray<float, TInlineAllocator<256>> LineHalfWidths;
+
+	// Markup state. Relayout never starts past the first line with markup or a path on, so the state always starts empty.
+	check((!Settings.bParseMarkup && Settings.PathMode == ENTTTextPathMode::NTT_TPM_None) || FirstLine == 0);
+	FNTTMarkupState Markup;
+	float MarkupScale = 1.0f;
+
+	// The first line always exists, even for empty text.
+	Layout.LineStartIndices.Add(FirstOutputIndex);
+	Layout.LineSourceStartIndices.Add(FirstSourceIndex);
+
+	auto FinishWord = [&]()
+	{
+		if (bInsideWord)
+		{
+			bInsideWord = false;
+			Layout.WordStartIndices.Add(CurrentWordStartIndex);
+			Layout.WordCharacterCounts.Add(CurrentWordCharCount);
+		}
+	};
+
+	auto FinishLine = [&]()
+	{
+		if (bDeferX)
+		{
+			FVector2f* LinePositions = Layout.CharacterPositions.GetData() + Layout.CharacterPositions.Num() - LineSteps.Num();
+			LineX = AccumulateLineX(LineSteps.GetData(), LineHalfWidths.GetData(), LineSteps.Num(), LinePositions) + PendingAdvance;
+			PendingAdvance = 0.0f;
+			LineSteps.Reset();
+			LineHalfWidths.Reset();
+		}
+
+		// With wrapping on, lines ended by a newline or the end of the text drop their trailing whitespace too, the same as wrapped lines,
+		// so alignment and line widths agree however the line ended.
+		Layout.LineWidths.Add(bWrap ? ContentEndX : LineX);
+		Layout.LineTops.Add(TotalHeight);
+		Layout.LineHeights.Add((MaxBottom > 0.0f) ? MaxBottom : GlyphTable.MaxGlyphHeight);
+		TotalHeight += Layout.LineHeights.Last();
+
+		LineX = 0.0f;
+		MaxBottom = 0.0f;
+		bPendingKerning = false;
+		ContentEndX = 0.0f;
+		bLineHasWord = false;
+	};
+
+	// Ends the line just before the current word and moves the word's characters so far to the start of a new line.
+	auto WrapCurrentWord = [&]()
+	{
+		Layout.LineWidths.Add(LineWidthBeforeWord);
+		Layout.LineTops.Add(TotalHeight);
+		Layout.LineHeights.Add((MaxBottomBeforeWord > 0.0f) ? MaxBottomBeforeWord : GlyphTable.MaxGlyphHeight);
+		TotalHeight += Layout.LineHeights.Last();
+		TotalHeight += Settings.VerticalOffset;
+
+		Layout.LineStartIndices.Add(CurrentWordStartIndex);
+		Layout.LineSourceStartIndices.Add(CurrentWordSourceIndex);
+
+		for (int32 CharIdx = CurrentWordStartIndex; CharIdx < Layout.Unicode.Num(); ++CharIdx)
+		{
+			if (Layout.GlyphIndices[CharIdx] != INDEX_NONE)
+			{
+				Layout.CharacterPositions[CharIdx].X -= WordStartX;
+			}
+		}
+
+		LineX -= WordStartX;
+		ContentEndX -= WordStartX;
+		MaxBottom = WordMaxBottom;
+		WordStartX = 0.0f;
+		bWordCanWrap = false;
+	};
+
+	int32 Index = FirstSourceIndex;
+	while (Index < TextLength)
+	{
+		const TCHAR Ch = Text[Index];
+
+		// Handle newlines as line separators, not drawable characters. CRLF is treated as a single newline.
+		if (Ch == '\n' || Ch == '\r')
+		{
+			Index += (Ch == '\r' && Index + 1 < TextLength && Text[Index + 1] == '\n') ? 2 : 1;
+
+			FinishLine();
+			bLineOpen = Index < TextLength;
+
+			if (bLineOpen)
+			{
+				TotalHeight += Settings.VerticalOffset;
+
+				// Newline breaks word in both modes.
+				FinishWord();
+
+				// Mark the start of the next line
+				Layout.LineStartIndices.Add(Layout.Unicode.Num());
+				Layout.LineSourceStartIndices.Add(Index);
+			}
+			continue;
+		}
+
+		// Markup tags only change the style of the characters after them; they aren't laid out and don't break words.
+		if (Ch == '<' && Settings.bParseMarkup)
+		{
+			if (const int32 TagLength = ParseMarkupTag(Text, Index, TextLength, Settings, Markup))
+			{
+				Index += TagLength;
+				MarkupScale = Markup.GetScale();
+				continue;
+			}
+		}
+
+		++Index;
+
+		const int32 Code = static_cast<int32>(Ch);
+		const bool bIsWhitespace = IsWhitespaceChar(Code);
+
+		// Kerning from the previous drawn character only applies if this character is not whitespace.
+		if (bPendingKerning && !FChar::IsWhitespace(Ch))
+		{
+			PenX += CharIncrement;
+		}
+		bPendingKerning = false;
+
+		// Handle word state transitions
+		if (bIsWhitespace)
+		{
+			FinishWord();
+		}
+		else
+		{
+			if (!bInsideWord)
+			{
+				bInsideWord = true;
+				CurrentWordStartIndex = Layout.Unicode.Num();
+				CurrentWordCharCount = 0;
+
+				CurrentWordSourceIndex = Index - 1;
+				WordStartX = LineX;
+				WordMaxBottom = 0.0f;
+				LineWidthBeforeWord = ContentEndX;
+				MaxBottomBeforeWord = MaxBottom;
+				bWordCanWrap = bLineHasWord;
+				bLineHasWord = true;
+			}
+			CurrentWordCharCount++;
+		}
+
+		// Characters that do not have glyph data keep a (0,0) position and don't advance the line.
+		const int32 GlyphIndex = GlyphTable.FindGlyphIndex(Code);
+		FVector2f Position(0.0f, 0.0f);
+		float HalfWidth = -1.0f;
+		if (GlyphIndex != INDEX_NONE)
+		{
+			const FVector2f& GlyphSize = GlyphTable.CharacterSpriteSizes[GlyphIndex];
+
+			// Scaled glyphs grow from the top of the line
+			float SizeX = GlyphSize.X * MarkupScale;
+			const float SizeY = GlyphSize.Y * MarkupScale;
+			const float TopY  = static_cast<float>(GlyphTable.VerticalOffsets[GlyphIndex]) * MarkupScale; // how far from the line's origin its top is
+
+			if (bIsWhitespace)
+			{
+				SizeX *= Settings.WhitespaceWidthMultiplier;
+			}
+			else if (bWrap && bWordCanWrap && LineX + SizeX > Settings.MaxLineWidth)
+			{
+				WrapCurrentWord();
+			}
+
+			MaxBottom = FMath::Max(MaxBottom, TopY + SizeY);
+
+			Position = FVector2f(LineX + SizeX * 0.5f, TopY + SizeY * 0.5f);
+			HalfWidth = SizeX * 0.5f;
+
+			PenX += SizeX;
+			bPendingKerning = true;
+
+			if (!bIsWhitespace)
+			{
+				WordMaxBottom = FMath::Max(WordMaxBottom, TopY + SizeY);
+				ContentEndX = LineX;
+			}
+		}
+
+		// Filter logic: if filtering is on and it's whitespace, skip output.
+		if (Settings.bFilterWhitespaceCharacters && bIsWhitespace)
+		{
+			continue;
+		}
+
+		Layout.Unicode.Add(Code);
+		Layout.GlyphIndices.Add(GlyphIndex);
+		Layout.CharacterPositions.Add(Position);
+
+		if (Settings.bParseMarkup)
+		{
+			Layout.CharacterColors.Add(Markup.GetColor());
+			Layout.CharacterScales.Add(MarkupScale);
+			Layout.CharacterStyles.Add(Markup.GetStyle());
+		}
+
+		if (bDeferX)
+		{
+			LineSteps.Add(PendingAdvance);
+			LineHalfWidths.Add(HalfWidth);
+			PendingAdvance = 0.0f;
+		}
+	}
+
+	if (bLineOpen)
+	{
+		FinishLine();
+	}
+	FinishWord();
+
+	Layout.TotalTextHeight = TotalHeight;
+
+	// Derive per-line character counts from the line start indices.
+	const int32 NumLineStarts = Layout.LineStartIndices.Num();
+	for (int32 LineIdx = FirstLine; LineIdx < NumLineStarts; ++LineIdx)
+	{
+		const int32 LineEnd = (LineIdx < NumLineStarts - 1) ? Layout.LineStartIndices[LineIdx + 1] : Layout.Unicode.Num();
+		Layout.LineCharacterCounts.Add(LineEnd - Layout.LineStartIndices[LineIdx]);
+	}
+
+	const float BlockOffsetY = GetBlockOffsetY(Settings.VerticalAlignment, TotalHeight);
+	Layout.BlockOffsetY = BlockOffsetY;
+
+	// Kept lines only move if the block height changed under center or bottom alignment.
+	const float KeptLinesDeltaY = BlockOffsetY - PreviousBlockOffsetY;
+	if (FirstOutputIndex > 0 && KeptLinesDeltaY != 0.0f)
+	{
+		for (int32 CharIdx = 0; CharIdx < FirstOutputIndex; ++CharIdx)
+		{
+			if (Layout.GlyphIndices[CharIdx] != INDEX_NONE)
+			{
+				Layout.CharacterPositions[CharIdx].Y += KeptLinesDeltaY;
+			}
+		}
+	}
+
+	// Horizontal alignment and line placement: shift every drawn character in the line by the line's start X and top.
+	const int32 NumLines = Layout.LineWidths.Num();
+	for (int32 LineIdx = FirstLine; LineIdx < NumLines; ++LineIdx)
+	{
+		const float StartX = GetLineStartX(Settings.HorizontalAlignment, Layout.LineWidths[LineIdx]);
+		const FVector2f LineOrigin(StartX, Layout.LineTops[LineIdx] + BlockOffsetY);
+		const int32 LineStart = Layout.LineStartIndices[LineIdx];
+		const int32 LineEnd = LineStart + Layout.LineCharacterCounts[LineIdx];
+		for (int32 CharIdx = LineStart; CharIdx < LineEnd; ++CharIdx)
+		{
+			if (Layout.GlyphIndices[CharIdx] != INDEX_NONE)
+			{
+				Layout.CharacterPositions[CharIdx] += LineOrigin;
+			}
+		}
+	}
+
+	if (Settings.PathMode != ENTTTextPathMode::NTT_TPM_None)
+	{
+		ApplyTextPath(Settings, Layout);
+	}
+
+	BuildBounds(Layout, FirstWordIndex, FirstOutputIndex > 0 ? KeptLinesDeltaY : 0.0f, [&GlyphTable, &Layout](int32 CharIdx)
+	{
+		const FVector2f& Size = GlyphTable.CharacterSpriteSizes[Layout.GlyphIndices[CharIdx]];
+		return Layout.CharacterScales.Num() > 0 ? Size * Layout.CharacterScales[CharIdx] : Size;
+	});
+	BuildCharacterIndices(Layout, FirstOutputIndex);
+	BuildPrefixSums(Layout);
+
+	// Only the relaid tail of the source string needs copying.
+	Layout.SourceText.LeftInline(FirstSourceIndex, NTT_NO_SHRINK);
+	Layout.SourceText.AppendChars(Text + FirstSourceIndex, TextLength - FirstSourceIndex);
+	Layout.Settings = Settings;
+}
+
+void FNTTTextLayoutEngine::Layout(const FNTTGlyphTable& GlyphTable, const FNTTTextLayoutSettings& Settings, const FString& InputText, FNTTTextLayout& OutLayout)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NTTTextLayoutEngine_Layout);
+
+	OutLayout.Reset();
+	LayoutFromLine(GlyphTable, Settings, InputText, 0, OutLayout);
+}
+
+void FNTTTextLayoutEngine::Relayout(const FNTTGlyphTable& GlyphTable, const FNTTTextLayoutSettings& Settings, const FString& InputText, FNTTTextLayout& InOutLayout)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NTTTextLayoutEngine_Relayout);
+
+	// Settings apply to every line, so changing them needs a full layout. So does a layout that never got as far as its first line,
+	// markup, since a tag opened on an earlier line still styles the edited ones, and a path, which bends every line.
+	if (!(InOutLayout.Settings == Settings) || InOutLayout.LineSourceStartIndices.Num() == 0 || Settings.bParseMarkup
+		|| Settings.PathMode != ENTTTextPathMode::NTT_TPM_None)
+	{
+		Layout(GlyphTable, Settings, InputText, InOutLayout);
+		return;
+	}
+
+	const FString& PreviousText = InOutLayout.SourceText;
+	const int32 CommonLength = FMath::Min(PreviousText.Len(), InputText.Len());
+	const TCHAR* PreviousChars = *PreviousText;
+	const TCHAR* NewChars = *InputText;
+
+	int32 PrefixLength = 0;
+	while (PrefixLength < CommonLength && PreviousChars[PrefixLength] == NewChars[PrefixLength])
+	{
+		++PrefixLength;
+	}
+
+	if (PrefixLength == PreviousText.Len() && PrefixLength == InputText.Len())
+	{
+		return;
+	}
+
+	// Start from the line holding the character before the edit, so a newline that gains or loses a following LF is relaid with its own line.
+	const int32 FirstChangedSourceIndex = FMath::Max(PrefixLength - 1, 0);
+	int32 FirstLine = FMath::Max(Algo::UpperBound(InOutLayout.LineSourceStartIndices, FirstChangedSourceIndex) - 1, 0);
+
+	// With wrapping, shortening the first word of a line can pull it back onto the line before.
+	if (Settings.MaxLineWidth > 0.0f)
+	{
+		FirstLine = FMath::Max(FirstLine - 1, 0);
+	}
+
+	LayoutFromLine(GlyphTable, Settings, InputText, FirstLine, InOutLayout);
+}
+
+// Writes the sign, the zero-padded (and optionally grouped) integer part and the fractional part, most significant digit first.
+static FNTTNumberText FormatNumber(bool bNegative, uint64 IntegerPart, uint64 FractionalPart, int32 FractionalDigits, const FNTTNumberFormat& Format)
+{
+	FNTTNumberText Number;
+
+	// Digits come out least significant first, so build the string backwards from the end of a scratch buffer.
+	TCHAR Scratch[FNTTNumberText::MaxChars];
+	int32 Start = FNTTNumberText::MaxChars;
+
+	for (int32 Digit = 0; Digit < FractionalDigits; ++Digit)
+	{
+		Scratch[--Start] = TCHAR('0' + FractionalPart % 10);
+		FractionalPart /= 10;
+	}
+	if (FractionalDigits > 0)
+	{
+		Scratch[--Start] = TCHAR('.');
+	}
+
+	const int32 MinimumIntegerDigits = FMath::Clamp(Format.MinimumIntegerDigits, 1, 19);
+	int32 NumIntegerDigits = 0;
+	while (IntegerPart > 0 || NumIntegerDigits < MinimumIntegerDigits)
+	{
+		if (Format.bUseGrouping && NumIntegerDigits > 0 && NumIntegerDigits % 3 == 0)
+		{
+			Scratch[--Start] = TCHAR(',');
+		}
+		Scratch[--Start] = TCHAR('0' + IntegerPart % 10);
+		IntegerPart /= 10;
+		++NumIntegerDigits;
+	}
+
+	if (bNegative)
+	{
+		Scratch[--Start] = TCHAR('-');
+	}
+	else if (Format.bAlwaysShowSign)
+	{
+		Scratch[--Start] = TCHAR('+');
+	}
+
+	Number.Len = FNTTNumberText::MaxChars - Start;
+	FMemory::Memcpy(Number.Chars, Scratch + Start, Number.Len * sizeof(TCHAR));
+	return Number;
+}
+
+FNTTNumberText FNTTNumberText::FromInteger(int64 Value, const FNTTNumberFormat& Format)
+{
+	// Negate through uint64 so MIN_int64 doesn't overflow.
+	const uint64 Magnitude = Value < 0 ? 0 - static_cast<uint64>(Value) : static_cast<uint64>(Value);
+	return FormatNumber(Value < 0, Magnitude, 0, 0, Format);
+}
+
+FNTTNumberText FNTTNumberText::FromFloat(double Value, const FNTTNumberFormat& Format)
+{
+	const int32 FractionalDigits = FMath::Clamp(Format.FractionalDigits, 0, 9);
+
+	uint64 Scale = 1;
+	for (int32 Digit = 0; Digit < FractionalDigits; ++Digit)
+	{
+		Scale *= 10;
+	}
+
+	// Round once in fixed point so e.g. 0.995 at two digits carries into the integer part.
+	double Scaled = FMath::IsNaN(Value) ? 0.0 : FMath::RoundHalfFromZero(Value * static_cast<double>(Scale));
+	Scaled = FMath::Clamp(Scaled, -9.0e18, 9.0e18);
+
+	const uint64 Magnitude = static_cast<uint64>(FMath::Abs(Scaled));
+	return FormatNumber(Scaled < 0.0, Magnitude / Scale, Magnitude % Scale, FractionalDigits, Format);
+}
+
+void FNTTNumberGlyphs::Build(const FNTTGlyphTable& GlyphTable)
+{
+	static const TCHAR SlotChars[NumSlots] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '-', '.', ',' };
+
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		const int32 GlyphIndex = GlyphTable.FindGlyphIndex(SlotChars[Slot]);
+		GlyphIndices[Slot] = GlyphIndex;
+		Sizes[Slot] = GlyphIndex != INDEX_NONE ? GlyphTable.CharacterSpriteSizes[GlyphIndex] : FVector2f::ZeroVector;
+		TopYs[Slot] = GlyphIndex != INDEX_NONE ? static_cast<float>(GlyphTable.VerticalOffsets[GlyphIndex]) : 0.0f;
+	}
+
+	Kerning = static_cast<float>(GlyphTable.Kerning);
+	MaxGlyphHeight = GlyphTable.MaxGlyphHeight;
+	bHasGlyphs = GlyphTable.NumGlyphs() > 0;
+	bBuilt = true;
+}
+
+void FNTTTextLayoutEngine::LayoutNumber(const FNTTNumberGlyphs& NumberGlyphs, const FNTTTextLayoutSettings& Settings, const FNTTNumberText& Number, FNTTTextLayout& OutLayout)
+{
+	OutLayout.Reset();
+
+	// Without glyph data there is nothing to lay out, same as Layout.
+	if (!NumberGlyphs.bHasGlyphs)
+	{
+		return;
+	}
+
+	const int32 NumChars = Number.Len;
+	const float CharIncrement = NumberGlyphs.Kerning + Settings.KerningOffset;
+
+	OutLayout.Unicode.SetNumUninitialized(NumChars, NTT_NO_SHRINK);
+	OutLayout.GlyphIndices.SetNumUninitialized(NumChars, NTT_NO_SHRINK);
+	OutLayout.CharacterPositions.SetNumUninitialized(NumChars, NTT_NO_SHRINK);
+
+	// A number has no whitespace, so it is one word on one line and only kerning and glyph widths move the pen.
+	float LineX = 0.0f;
+	float MaxBottom = 0.0f;
+	bool bPendingKerning = false;
+	for (int32 CharIdx = 0; CharIdx < NumChars; ++CharIdx)
+	{
+		const TCHAR Ch = Number.Chars[CharIdx];
+		const int32 Slot = FNTTNumberGlyphs::GetSlot(Ch);
+		const int32 GlyphIndex = NumberGlyphs.GlyphIndices[Slot];
+
+		if (bPendingKerning)
+		{
+			LineX += CharIncrement;
+		}
+		bPendingKerning = false;
+
+		FVector2f Position(0.0f, 0.0f);
+		if (GlyphIndex != INDEX_NONE)
+		{
+			const FVector2f& GlyphSize = NumberGlyphs.Sizes[Slot];
+			const float TopY = NumberGlyphs.TopYs[Slot];
+
+			MaxBottom = FMath::Max(MaxBottom, TopY + GlyphSize.Y);
+			Position = FVector2f(LineX + GlyphSize.X * 0.5f, TopY + GlyphSize.Y * 0.5f);
+
+			LineX += GlyphSize.X;
+			bPendingKerning = true;
+		}
+
+		OutLayout.Unicode[CharIdx] = static_cast<int32>(Ch);
+		OutLayout.GlyphIndices[CharIdx] = GlyphIndex;
+		OutLayout.CharacterPositions[CharIdx] = Position;
+	}
+
+	const float TotalHeight = (MaxBottom > 0.0f) ? MaxBottom : NumberGlyphs.MaxGlyphHeight;
+	OutLayout.TotalTextHeight = TotalHeight;
+	OutLayout.BlockOffsetY = GetBlockOffsetY(Settings.VerticalAlignment, TotalHeight);
+
+	OutLayout.LineStartIndices.Add(0);
+	OutLayout.LineCharacterCounts.Add(NumChars);
+	OutLayout.LineSourceStartIndices.Add(0);
+	OutLayout.LineWidths.Add(LineX);
+	OutLayout.LineTops.Add(0.0f);
+	OutLayout.LineHeights.Add(TotalHeight);
+	if (NumChars > 0)
+	{
+		OutLayout.WordStartIndices.Add(0);
+		OutLayout.WordCharacterCounts.Add(NumChars);
+	}
+
+	const FVector2f LineOrigin(GetLineStartX(Settings.HorizontalAlignment, LineX), OutLayout.BlockOffsetY);
+	for (int32 CharIdx = 0; CharIdx < NumChars; ++CharIdx)
+	{
+		if (OutLayout.GlyphIndices[CharIdx] != INDEX_NONE)
+		{
+			OutLayout.CharacterPositions[CharIdx] += LineOrigin;
+		}
+	}
+
+	if (Settings.PathMode != ENTTTextPathMode::NTT_TPM_None)
+	{
+		ApplyTextPath(Settings, OutLayout);
+	}
+
+	BuildBounds(OutLayout, 0, 0.0f, [&NumberGlyphs, &Number](int32 CharIdx)
+	{
+		return NumberGlyphs.Sizes[FNTTNumberGlyphs::GetSlot(Number.Chars[CharIdx])];
+	});
+	BuildCharacterIndices(OutLayout, 0);
+	BuildPrefixSums(OutLayout);
+
+	// Kept so the layout can later be relaid out as regular text.
+	OutLayout.SourceText.AppendChars(Number.Chars, NumChars);
+	OutLayout.Settings = Settings;
+}
+
+void FNTTTextLayoutEngine::LayoutBatch(const FNTTGlyphTable& GlyphTable, const FNTTTextLayoutSettings& Settings, TArrayView<const FString> InputTexts, FNTTTextLayoutBatch& OutBatch)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NTTTextLayoutEngine_LayoutBatch);
+
+	const int32 NumTexts = InputTexts.Num();
+
+	// Give every string a slot sized for the most it could produce, so workers can write their results without coordinating:
+	// at most one character per source character, one line per source character plus the first, and one word per two source characters.
+	OutBatch.Ranges.SetNumUninitialized(NumTexts, NTT_NO_SHRINK);
+	int32 CharacterCapacity = 0;
+	int32 LineCapacity = 0;
+	int32 WordCapacity = 0;
+	for (int32 TextIndex = 0; TextIndex < NumTexts; ++TextIndex)
+	{
+		const int32 TextLength = InputTexts[TextIndex].Len();
+		FNTTTextLayoutBatch::FRange& Range = OutBatch.Ranges[TextIndex];
+		Range.CharacterStart = CharacterCapacity;
+		Range.LineStart = LineCapacity;
+		Range.WordStart = WordCapacity;
+		CharacterCapacity += TextLength;
+		LineCapacity += TextLength + 1;
+		WordCapacity += TextLength / 2 + 1;
+	}
+
+	OutBatch.Unicode.SetNumUninitialized(CharacterCapacity, NTT_NO_SHRINK);
+	OutBatch.GlyphIndices.SetNumUninitialized(CharacterCapacity, NTT_NO_SHRINK);
+	OutBatch.CharacterPositions.SetNumUninitialized(CharacterCapacity, NTT_NO_SHRINK);
+	OutBatch.LineStartIndices.SetNumUninitialized(LineCapacity, NTT_NO_SHRINK);
+	OutBatch.LineCharacterCounts.SetNumUninitialized(LineCapacity, NTT_NO_SHRINK);
+	OutBatch.WordStartIndices.SetNumUninitialized(WordCapacity, NTT_NO_SHRINK);
+	OutBatch.WordCharacterCounts.SetNumUninitialized(WordCapacity, NTT_NO_SHRINK);
+	OutBatch.CharacterLineIndices.SetNumUninitialized(CharacterCapacity, NTT_NO_SHRINK);
+	OutBatch.CharacterWordIndices.SetNumUninitialized(CharacterCapacity, NTT_NO_SHRINK);
+
+	const int32 StyleCapacity = Settings.bParseMarkup ? CharacterCapacity : 0;
+	OutBatch.CharacterColors.SetNumUninitialized(StyleCapacity, NTT_NO_SHRINK);
+	OutBatch.CharacterScales.SetNumUninitialized(StyleCapacity, NTT_NO_SHRINK);
+	OutBatch.CharacterStyles.SetNumUninitialized(StyleCapacity, NTT_NO_SHRINK);
+
+	const bool bHasPath = Settings.PathMode != ENTTTextPathMode::NTT_TPM_None;
+	OutBatch.CharacterRotations.SetNumUninitialized(bHasPath ? CharacterCapacity : 0, NTT_NO_SHRINK);
+
+	// Each worker lays out into its own scratch layout, which keeps its allocations across the strings it processes.
+	TArray<FNTTTextLayout> WorkerLayouts;
+	ParallelForWithTaskContext(TEXT("NTTTextLayoutBatch"), WorkerLayouts, NumTexts, 16,
+		[](int32 ContextIndex, int32 NumContexts) { return FNTTTextLayout(); },
+		[&](FNTTTextLayout& Scratch, int32 TextIndex)
+		{
+			Layout(GlyphTable, Settings, InputTexts[TextIndex], Scratch);
+
+			FNTTTextLayoutBatch::FRange& Range = OutBatch.Ranges[TextIndex];
+			Range.NumCharacters = Scratch.Unicode.Num();
+			Range.NumLines = Scratch.LineStartIndices.Num();
+			Range.NumWords = Scratch.WordStartIndices.Num();
+			Range.TotalTextHeight = Scratch.TotalTextHeight;
+
+			FMemory::Memcpy(OutBatch.Unicode.GetData() + Range.CharacterStart, Scratch.Unicode.GetData(), Range.NumCharacters * sizeof(int32));
+			FMemory::Memcpy(OutBatch.GlyphIndices.GetData() + Range.CharacterStart, Scratch.GlyphIndices.GetData(), Range.NumCharacters * sizeof(int32));
+			FMemory::Memcpy(OutBatch.CharacterPositions.GetData() + Range.CharacterStart, Scratch.CharacterPositions.GetData(), Range.NumCharacters * sizeof(FVector2f));
+			FMemory::Memcpy(OutBatch.LineStartIndices.GetData() + Range.LineStart, Scratch.LineStartIndices.GetData(), Range.NumLines * sizeof(int32));
+			FMemory::Memcpy(OutBatch.LineCharacterCounts.GetData() + Range.LineStart, Scratch.LineCharacterCounts.GetData(), Range.NumLines * sizeof(int32));
+			FMemory::Memcpy(OutBatch.WordStartIndices.GetData() + Range.WordStart, Scratch.WordStartIndices.GetData(), Range.NumWords * sizeof(int32));
+			FMemory::Memcpy(OutBatch.WordCharacterCounts.GetData() + Range.WordStart, Scratch.WordCharacterCounts.GetData(), Range.NumWords * sizeof(int32));
+			FMemory::Memcpy(OutBatch.CharacterLineIndices.GetData() + Range.CharacterStart, Scratch.CharacterLineIndices.GetData(), Range.NumCharacters * sizeof(int32));
+			FMemory::Memcpy(OutBatch.CharacterWordIndices.GetData() + Range.CharacterStart, Scratch.CharacterWordIndices.GetData(), Range.NumCharacters * sizeof(int32));
+
+			if (Settings.bParseMarkup)
+			{
+				FMemory::Memcpy(OutBatch.CharacterColors.GetData() + Range.CharacterStart, Scratch.CharacterColors.GetData(), Range.NumCharacters * sizeof(FColor));
+				FMemory::Memcpy(OutBatch.CharacterScales.GetData() + Range.CharacterStart, Scratch.CharacterScales.GetData(), Range.NumCharacters * sizeof(float));
+				FMemory::Memcpy(OutBatch.CharacterStyles.GetData() + Range.CharacterStart, Scratch.CharacterStyles.GetData(), Range.NumCharacters * sizeof(int32));
+			}
+			if (bHasPath)
+			{
+				FMemory::Memcpy(OutBatch.CharacterRotations.GetData() + Range.CharacterStart, Scratch.CharacterRotations.GetData(), Range.NumCharacters * sizeof(float));
+			}
+		});
+
+	// Close the gaps left by the worst-case slots. Every slice only moves towards the front, so this is a single in-place forward pass.
+	int32 NumCharacters = 0;
+	int32 NumLines = 0;
+	int32 NumWords = 0;
+	for (FNTTTextLayoutBatch::FRange& Range : OutBatch.Ranges)
+	{
+		if (Range.CharacterStart != NumCharacters)
+		{
+			FMemory::Memmove(OutBatch.Unicode.GetData() + NumCharacters, OutBatch.Unicode.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(int32));
+			FMemory::Memmove(OutBatch.GlyphIndices.GetData() + NumCharacters, OutBatch.GlyphIndices.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(int32));
+			FMemory::Memmove(OutBatch.CharacterPositions.GetData() + NumCharacters, OutBatch.CharacterPositions.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(FVector2f));
+			FMemory::Memmove(OutBatch.CharacterLineIndices.GetData() + NumCharacters, OutBatch.CharacterLineIndices.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(int32));
+			FMemory::Memmove(OutBatch.CharacterWordIndices.GetData() + NumCharacters, OutBatch.CharacterWordIndices.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(int32));
+			if (Settings.bParseMarkup)
+			{
+				FMemory::Memmove(OutBatch.CharacterColors.GetData() + NumCharacters, OutBatch.CharacterColors.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(FColor));
+				FMemory::Memmove(OutBatch.CharacterScales.GetData() + NumCharacters, OutBatch.CharacterScales.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(float));
+				FMemory::Memmove(OutBatch.CharacterStyles.GetData() + NumCharacters, OutBatch.CharacterStyles.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(int32));
+			}
+			if (bHasPath)
+			{
+				FMemory::Memmove(OutBatch.CharacterRotations.GetData() + NumCharacters, OutBatch.CharacterRotations.GetData() + Range.CharacterStart, Range.NumCharacters * sizeof(float));
+			}
+			Range.CharacterStart = NumCharacters;
+		}
+		if (Range.LineStart != NumLines)
+		{
+			FMemory::Memmove(OutBatch.LineStartIndices.GetData() + NumLines, OutBatch.LineStartIndices.GetData() + Range.LineStart, Range.NumLines * sizeof(int32));
+			FMemory::Memmove(OutBatch.LineCharacterCounts.GetData() + NumLines, OutBatch.LineCharacterCounts.GetData() + Range.LineStart, Range.NumLines * sizeof(int32));
+			Range.LineStart = NumLines;
+		}
+		if (Range.WordStart != NumWords)
+		{
+			FMemory::Memmove(OutBatch.WordStartIndices.GetData() + NumWords, OutBatch.WordStartIndices.GetData() + Range.WordStart, Range.NumWords * sizeof(int32));
+			FMemory::Memmove(OutBatch.WordCharacterCounts.GetData() + NumWords, OutBatch.WordCharacterCounts.GetData() + Range.WordStart, Range.NumWords * sizeof(int32));
+			Range.WordStart = NumWords;
+		}
+		NumCharacters += Range.NumCharacters;
+		NumLines += Range.NumLines;
+		NumWords += Range.NumWords;
+	}
+
+	OutBatch.Unicode.SetNum(NumCharacters, NTT_NO_SHRINK);
+	OutBatch.GlyphIndices.SetNum(NumCharacters, NTT_NO_SHRINK);
+	OutBatch.CharacterPositions.SetNum(NumCharacters, NTT_NO_SHRINK);
+	OutBatch.LineStartIndices.SetNum(NumLines, NTT_NO_SHRINK);
+	OutBatch.LineCharacterCounts.SetNum(NumLines, NTT_NO_SHRINK);
+	OutBatch.WordStartIndices.SetNum(NumWords, NTT_NO_SHRINK);
+	OutBatch.WordCharacterCounts.SetNum(NumWords, NTT_NO_SHRINK);
+	OutBatch.CharacterLineIndices.SetNum(NumCharacters, NTT_NO_SHRINK);
+	OutBatch.CharacterWordIndices.SetNum(NumCharacters, NTT_NO_SHRINK);
+	if (Settings.bParseMarkup)
+	{
+		OutBatch.CharacterColors.SetNum(NumCharacters, NTT_NO_SHRINK);
+		OutBatch.CharacterScales.SetNum(NumCharacters, NTT_NO_SHRINK);
+		OutBatch.CharacterStyles.SetNum(NumCharacters, NTT_NO_SHRINK);
+	}
+	if (bHasPath)
+	{
+		OutBatch.CharacterRotations.SetNum(NumCharacters, NTT_NO_SHRINK);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+// Times the layout engine on generated text of increasing length. Usage: NTT.BenchmarkLayout [Iterations]
+static FAutoConsoleCommand GNTTBenchmarkLayoutCommand(
+	TEXT("NTT.BenchmarkLayout"),
+	TEXT("Times full and incremental NTT text layout on generated 1k, 10k and 100k character inputs, batched labels and numeric counters. Usage: NTT.BenchmarkLayout [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 20;
+
+		// Synthetic printable-ASCII font so the benchmark doesn't depend on content.
+		FNTTGlyphTable GlyphTable;
+		for (int32 Codepoint = ' '; Codepoint <= '~'; ++Codepoint)
+		{
+			GlyphTable.AddGlyph(Codepoint, FVector4f(0.01f, 0.02f, 0.0f, 0.0f), FVector2f(8.0f + (Codepoint % 7), 16.0f), Codepoint % 3, 0);
+		}
+		// Cyrillic, for the mixed input
+		for (int32 Codepoint = 0x410; Codepoint <= 0x44F; ++Codepoint)
+		{
+			GlyphTable.AddGlyph(Codepoint, FVector4f(0.01f, 0.02f, 0.0f, 0.0f), FVector2f(9.0f + (Codepoint % 5), 16.0f), Codepoint % 2, 0);
+		}
+
+		const FNTTTextLayoutSettings Settings;
+		FNTTTextLayout Layout;
+
+		for (const int32 NumCharacters : { 1000, 10000, 100000 })
+		{
+			FString Text;
+			Text.Reserve(NumCharacters);
+			for (int32 i = 0; i < NumCharacters; ++i)
+			{
+				Text.AppendChar((i % 61 == 60) ? TCHAR('\n') : (i % 7 == 6) ? TCHAR(' ') : TCHAR('a' + (i % 26)));
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				FNTTTextLayoutEngine::Layout(GlyphTable, Settings, Text, Layout);
+			}
+			const double AverageMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+
+			UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT.BenchmarkLayout: %6d chars -> %.4f ms per layout (%.1f Mchars/s, %d iterations)"),
+				NumCharacters, AverageMs, AverageMs > 0.0 ? (NumCharacters / (AverageMs * 1000.0)) : 0.0, Iterations);
+
+			// Typewriter-style edit: alternate between the text and the text with a few characters appended.
+			const FString AppendedText = Text + TEXT("abc def");
+			FNTTTextLayoutEngine::Layout(GlyphTable, Settings, Text, Layout);
+
+			const double RelayoutStartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				FNTTTextLayoutEngine::Relayout(GlyphTable, Settings, (Iteration & 1) ? Text : AppendedText, Layout);
+			}
+			const double RelayoutAverageMs = (FPlatformTime::Seconds() - RelayoutStartTime) * 1000.0 / Iterations;
+
+			UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT.BenchmarkLayout: %6d chars -> %.4f ms per append relayout"), NumCharacters, RelayoutAverageMs);
+		}
+
+		// Vectorized against scalar X resolution, on long ASCII lines and on lines mixing ASCII, Cyrillic and characters the font doesn't have.
+		{
+			FString AsciiText;
+			FString MixedText;
+			const int32 NumCharacters = 100000;
+			AsciiText.Reserve(NumCharacters);
+			MixedText.Reserve(NumCharacters);
+			for (int32 i = 0; i < NumCharacters; ++i)
+			{
+				const bool bLineBreak = (i % 1000 == 999);
+				const bool bSpace = (i % 7 == 6);
+				AsciiText.AppendChar(bLineBreak ? TCHAR('\n') : bSpace ? TCHAR(' ') : TCHAR('a' + (i % 26)));
+				MixedText.AppendChar(bLineBreak ? TCHAR('\n') : bSpace ? TCHAR(' ')
+					: (i % 3 == 0) ? TCHAR(0x410 + (i % 64))
+					: (i % 11 == 0) ? TCHAR(0x4E00 + (i % 100))
+					: TCHAR('A' + (i % 26)));
+			}
+
+			const int32 PreviousVectorized = GNTTLayoutVectorized;
+			for (const FString* Text : { &AsciiText, &MixedText })
+			{
+				double AverageMs[2];
+				for (int32 Vectorized = 0; Vectorized < 2; ++Vectorized)
+				{
+					GNTTLayoutVectorized = Vectorized;
+					const double StartTime = FPlatformTime::Seconds();
+					for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+					{
+						FNTTTextLayoutEngine::Layout(GlyphTable, Settings, *Text, Layout);
+					}
+					AverageMs[Vectorized] = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+				}
+
+				UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT.BenchmarkLayout: %d chars %s -> %.4f ms scalar, %.4f ms vectorized"),
+					NumCharacters, Text == &AsciiText ? TEXT("ASCII") : TEXT("mixed"), AverageMs[0], AverageMs[1]);
+			}
+			GNTTLayoutVectorized = PreviousVectorized;
+		}
+
+		// Many short labels, laid out one by one and then as a single batch.
+		TArray<FString> Labels;
+		Labels.Reserve(1000);
+		for (int32 LabelIndex = 0; LabelIndex < 1000; ++LabelIndex)
+		{
+			Labels.Add(FString::Printf(TEXT("Loot Tag %d\n+%d XP"), LabelIndex, LabelIndex * 7));
+		}
+
+		const double SequentialStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FString& Label : Labels)
+			{
+				FNTTTextLayoutEngine::Layout(GlyphTable, Settings, Label, Layout);
+			}
+		}
+		const double SequentialAverageMs = (FPlatformTime::Seconds() - SequentialStartTime) * 1000.0 / Iterations;
+
+		FNTTTextLayoutBatch Batch;
+		const double BatchStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			FNTTTextLayoutEngine::LayoutBatch(GlyphTable, Settings, Labels, Batch);
+		}
+		const double BatchAverageMs = (FPlatformTime::Seconds() - BatchStartTime) * 1000.0 / Iterations;
+
+		UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT.BenchmarkLayout: %d labels -> %.4f ms one by one, %.4f ms batched"), Labels.Num(), SequentialAverageMs, BatchAverageMs);
+
+		// Score counter ticking 1000 times: formatted into an FString and laid out as text, against the numeric path.
+		const int32 NumCounterUpdates = 1000;
+		const double StringCounterStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (int32 Update = 0; Update < NumCounterUpdates; ++Update)
+			{
+				FNTTTextLayoutEngine::Layout(GlyphTable, Settings, FString::Printf(TEXT("%lld"), Update * 7919LL), Layout);
+			}
+		}
+		const double StringCounterAverageMs = (FPlatformTime::Seconds() - StringCounterStartTime) * 1000.0 / Iterations;
+
+		FNTTNumberGlyphs NumberGlyphs;
+		NumberGlyphs.Build(GlyphTable);
+		const FNTTNumberFormat NumberFormat;
+		const double NumberCounterStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (int32 Update = 0; Update < NumCounterUpdates; ++Update)
+			{
+				FNTTTextLayoutEngine::LayoutNumber(NumberGlyphs, Settings, FNTTNumberText::FromInteger(Update * 7919LL, NumberFormat), Layout);
+			}
+		}
+		const double NumberCounterAverageMs = (FPlatformTime::Seconds() - NumberCounterStartTime) * 1000.0 / Iterations;
+
+		UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT.BenchmarkLayout: %d counter updates -> %.4f ms as text, %.4f ms numeric"), NumCounterUpdates, StringCounterAverageMs, NumberCounterAverageMs);
+	}));
+
+#endif
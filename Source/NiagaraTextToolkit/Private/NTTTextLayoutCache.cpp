@@ -0,0 +1,137 @@
+// Property of Lucian Tranc
+
+#include "NTTTextLayoutCache.h"
+#include "NTTDataInterface.h"
+#include "Hash/CityHash.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarNTTLayoutCacheMaxSizeKB(
+	TEXT("NTT.LayoutCache.MaxSizeKB"),
+	2048,
+	TEXT("Memory budget in KB for cached NTT text layouts. Least recently used layouts are evicted once the cache goes over it. 0 disables the cache."),
+	ECVF_Default);
+
+// Upper bound on the number of entries regardless of size, so a flood of tiny layouts can't grow the LRU list without limit
+static constexpr int32 NTTLayoutCacheMaxEntries = 4096;
+
+FNTTTextLayoutCache& FNTTTextLayoutCache::Get()
+{
+	static FNTTTextLayoutCache Instance;
+	return Instance;
+}
+
+FNTTTextLayoutCache::FNTTTextLayoutCache()
+	: Entries(NTTLayoutCacheMaxEntries)
+{
+}
+
+uint64 FNTTTextLayoutCache::HashText(const FString& Text, const FNTTTextLayoutSettings& Settings)
+{
+	// Hash the settings field by field so struct padding never leaks into the key.
+	const uint32 SettingsWords[] =
+	{
+		static_cast<uint32>(Settings.HorizontalAlignment),
+		static_cast<uint32>(Settings.VerticalAlignment),
+		BitCast<uint32>(Settings.VerticalOffset),
+		BitCast<uint32>(Settings.KerningOffset),
+		BitCast<uint32>(Settings.WhitespaceWidthMultiplier),
+		Settings.bFilterWhitespaceCharacters ? 1u : 0u,
+		BitCast<uint32>(Settings.MaxLineWidth),
+		Settings.bParseMarkup ? 1u : 0u,
+		static_cast<uint32>(Settings.PathMode),
+		BitCast<uint32>(Settings.ArcRadius),
+		BitCast<uint32>(Settings.ArcStartAngle),
+	};
+
+	uint64 SettingsHash = CityHash64(reinterpret_cast<const char*>(SettingsWords), sizeof(SettingsWords));
+	for (const FName& StyleName : Settings.MarkupStyles)
+	{
+		SettingsHash = CityHash128to64(Uint128_64(SettingsHash, GetTypeHash(StyleName)));
+	}
+	if (Settings.PathPoints.Num() > 0)
+	{
+		SettingsHash = CityHash64WithSeed(reinterpret_cast<const char*>(Settings.PathPoints.GetData()), Settings.PathPoints.Num() * sizeof(FVector2f), SettingsHash);
+	}
+	return CityHash64WithSeed(reinterpret_cast<const char*>(*Text), Text.Len() * sizeof(TCHAR), SettingsHash);
+}
+
+uint64 FNTTTextLayoutCache::MakeKey(const FNTTGlyphTablePtr& GlyphTable, uint64 TextHash)
+{
+	return CityHash128to64(Uint128_64(TextHash, reinterpret_cast<uint64>(GlyphTable.Get())));
+}
+
+FNTTTextLayoutPtr FNTTTextLayoutCache::Find(uint64 Key, const FNTTGlyphTablePtr& GlyphTable, const FString& Text, const FNTTTextLayoutSettings& Settings)
+{
+	FScopeLock Lock(&CacheLock);
+
+	const FEntry* Entry = Entries.FindAndTouch(Key);
+	if (Entry && Entry->GlyphTable == GlyphTable && Entry->Layout->Settings == Settings && Entry->Layout->SourceText.Equals(Text, ESearchCase::CaseSensitive))
+	{
+		return Entry->Layout;
+	}
+	return nullptr;
+}
+
+void FNTTTextLayoutCache::Add(uint64 Key, const FNTTGlyphTablePtr& GlyphTable, const FNTTTextLayoutPtr& Layout)
+{
+	const SIZE_T MaxBytes = static_cast<SIZE_T>(FMath::Max(CVarNTTLayoutCacheMaxSizeKB.GetValueOnAnyThread(), 0)) * 1024;
+
+	FEntry NewEntry;
+	NewEntry.GlyphTable = GlyphTable;
+	NewEntry.Layout = Layout;
+	NewEntry.SizeBytes = sizeof(FNTTTextLayout) + Layout->GetAllocatedSize();
+
+	FScopeLock Lock(&CacheLock);
+
+	// Replace any entry already using this key (a collision, or a layout that was rebuilt).
+	if (const FEntry* Existing = Entries.Find(Key))
+	{
+		TotalBytes -= Existing->SizeBytes;
+		Entries.Remove(Key);
+	}
+
+	// Layouts bigger than the whole budget are never cached.
+	if (NewEntry.SizeBytes > MaxBytes)
+	{
+		EvictToBudget(MaxBytes);
+		return;
+	}
+
+	EvictToBudget(MaxBytes - NewEntry.SizeBytes);
+	if (Entries.Num() >= Entries.Max())
+	{
+		TotalBytes -= Entries.RemoveLeastRecent().SizeBytes;
+	}
+
+	TotalBytes += NewEntry.SizeBytes;
+	Entries.Add(Key, MoveTemp(NewEntry));
+}
+
+void FNTTTextLayoutCache::EvictToBudget(SIZE_T MaxBytes)
+{
+	while (TotalBytes > MaxBytes && Entries.Num() > 0)
+	{
+		TotalBytes -= Entries.RemoveLeastRecent().SizeBytes;
+	}
+}
+
+void FNTTTextLayoutCache::Empty()
+{
+	FScopeLock Lock(&CacheLock);
+	Entries.Empty(NTTLayoutCacheMaxEntries);
+	TotalBytes = 0;
+}
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommand GNTTLayoutCacheFlushCommand(
+	TEXT("NTT.LayoutCache.Flush"),
+	TEXT("Drops every cached NTT text layout. Instances keep the layouts they already use."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FNTTTextLayoutCache::Get().Empty();
+		UE_LOG(LogNiagaraTextToolkit, Display, TEXT("NTT Layout Cache: Flushed"));
+	}));
+
+#endif
@@ -3,6 +3,10 @@
 // NiagaraTextToolkit.cpp
 
 #include "NiagaraTextToolkit.h"
+#include "NTTFontCache.h"
+#include "NTTTextLayoutCache.h"
+#include "NTTBufferPool.h"
+#include "RenderingThread.h"
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/Paths.h"
@@ -14,10 +18,19 @@ void FNiagaraTextToolkitModule::StartupModule()
 {
     FString PluginShaderDir = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("NiagaraTextToolkit"))->GetBaseDir(), TEXT("Shaders"));
     AddShaderSourceDirectoryMapping(TEXT("/Plugin/NiagaraTextToolkit"), PluginShaderDir);
+
+    FNTTFontCache::Get().Initialize();
 }
 
 void FNiagaraTextToolkitModule::ShutdownModule()
 {
+    FNTTTextLayoutCache::Get().Empty();
+    FNTTFontCache::Get().Shutdown();
+
+    ENQUEUE_RENDER_COMMAND(NTTEmptyBufferPool)([](FRHICommandListImmediate& RHICmdList)
+    {
+        FNTTBufferPool::Get().Empty();
+    });
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -7,19 +7,36 @@
 #include "NiagaraUserRedirectionParameterStore.h"
 #include "NTTDataInterface.h"
 
-void UNiagaraTextToolkitHelpers::SetNiagaraNTTTextVariable(UNiagaraComponent* System, FString TextToDisplay)
+void UNiagaraTextToolkitHelpers::SetNiagaraNTTTextVariable(UNiagaraComponent* System, FString TextToDisplay, ENTTLayoutMode LayoutMode)
 {
 	UNTTDataInterface* FoundDI = FindNTTDataInterface(System);
 
 	if (FoundDI)
 	{
-		FoundDI->InputText = TextToDisplay;
+		// Running instances lay the new text out on their next tick, so no reinitialize is needed
+		FoundDI->SetText(TextToDisplay, LayoutMode);
+	}
+}
 
-		// Only reinitialize if the component is currently active
-		if (System && System->IsActive() && System->GetSystemInstanceController())
-		{
-			System->ReinitializeSystem();
-		}
+void UNiagaraTextToolkitHelpers::SetNiagaraNTTIntegerVariable(UNiagaraComponent* System, int64 Value, FNTTNumberFormat Format)
+{
+	UNTTDataInterface* FoundDI = FindNTTDataInterface(System);
+
+	if (FoundDI)
+	{
+		// Running instances pick the number up on their next tick, so no reinitialize is needed
+		FoundDI->SetNumber(Value, Format);
+	}
+}
+
+void UNiagaraTextToolkitHelpers::SetNiagaraNTTFloatVariable(UNiagaraComponent* System, double Value, FNTTNumberFormat Format)
+{
+	UNTTDataInterface* FoundDI = FindNTTDataInterface(System);
+
+	if (FoundDI)
+	{
+		// Running instances pick the number up on their next tick, so no reinitialize is needed
+		FoundDI->SetFloatNumber(Value, Format);
 	}
 }
 
@@ -29,13 +46,45 @@ void UNiagaraTextToolkitHelpers::SetNiagaraNTTFontVariable(UNiagaraComponent* Sy
 
 	if (FoundDI)
 	{
-		FoundDI->FontAsset = Font;
+		// Running instances switch fonts on their next tick, so no reinitialize is needed
+		FoundDI->SetFont(Font);
+	}
+}
+
+void UNiagaraTextToolkitHelpers::SetNiagaraNTTFontMetricsVariable(UNiagaraComponent* System, UNTTFontMetrics* FontMetrics)
+{
+	UNTTDataInterface* FoundDI = FindNTTDataInterface(System);
 
-		// Only reinitialize if the component is currently active
-		if (System && System->IsActive() && System->GetSystemInstanceController())
+	if (FoundDI)
+	{
+		// Running instances switch fonts on their next tick, so no reinitialize is needed
+		FoundDI->SetFontMetrics(FontMetrics);
+	}
+}
+
+void UNiagaraTextToolkitHelpers::SetNiagaraNTTPathFromSpline(UNiagaraComponent* System, USplineComponent* Spline, int32 NumSamples)
+{
+	UNTTDataInterface* FoundDI = FindNTTDataInterface(System);
+
+	if (FoundDI && Spline)
+	{
+		NumSamples = FMath::Max(NumSamples, 2);
+		const float SplineLength = Spline->GetSplineLength();
+		const FTransform& SystemTransform = System->GetComponentTransform();
+
+		TArray<FVector2D> Points;
+		Points.Reserve(NumSamples);
+		for (int32 SampleIdx = 0; SampleIdx < NumSamples; ++SampleIdx)
 		{
-			System->ReinitializeSystem();
+			const float Distance = SplineLength * SampleIdx / (NumSamples - 1);
+			const FVector LocalPoint = SystemTransform.InverseTransformPosition(Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World));
+
+			// Undo the flip GetCharacterPosition applies: text space X is -Y and text space Y is -Z
+			Points.Add(FVector2D(-LocalPoint.Y, -LocalPoint.Z));
 		}
+
+		// Running instances bend the text along the new path on their next tick, so no reinitialize is needed
+		FoundDI->SetPath(MoveTemp(Points), ENTTTextPathMode::NTT_TPM_Path);
 	}
 }
 
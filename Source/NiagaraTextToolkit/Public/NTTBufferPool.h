@@ -0,0 +1,50 @@
+// Property of Lucian Tranc
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderResource.h"
+
+// Render-thread pool of the structured buffers behind the glyph and text buffer registries.
+// Buffers are bucketed by power-of-two size, so the buffer freed when one text or font goes away is reused by the next one of a similar size
+// instead of being destroyed and recreated on the RHI. Spawning and killing floating text settles into reusing the same few buffers.
+class NIAGARATEXTTOOLKIT_API FNTTBufferPool
+{
+public:
+	static FNTTBufferPool& Get();
+
+	struct FStats
+	{
+		// Acquires served from the pool, and acquires that had to create a buffer
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		// Bytes held by every buffer the pool created and hasn't freed, in use or not
+		uint64 ResidentBytes = 0;
+		// Bytes held by buffers waiting in the pool
+		uint64 PooledBytes = 0;
+		int32 NumPooledBuffers = 0;
+	};
+
+	// Returns a buffer holding at least NumElements elements of BytesPerElement (a power of two), reusing a pooled one of the same
+	// stride and size class when there is one. Its contents are undefined. Render thread only.
+	FRWBufferStructured Acquire(FRHICommandListBase& RHICmdList, const TCHAR* DebugName, uint32 BytesPerElement, uint32 NumElements);
+
+	// Returns a buffer from Acquire to the pool, or frees it if the pool is over NTT.BufferPool.MaxSizeKB. Buffer is left empty. Render thread only.
+	void Release(FRWBufferStructured& Buffer);
+
+	// Frees every pooled buffer. Buffers in use are unaffected. Render thread only.
+	void Empty();
+
+	// Render thread only
+	const FStats& GetStats() const { return Stats; }
+
+private:
+	// Buffers are never smaller than this, so tiny texts share one size class
+	static constexpr uint32 MinBufferBytes = 256;
+	static constexpr int32 NumSizeClasses = 32;
+
+	static uint32 GetSizeClass(uint32 NumBytes);
+
+	TArray<FRWBufferStructured> FreeBuffers[NumSizeClasses];
+	FStats Stats;
+};
@@ -5,6 +5,14 @@
 #include "NiagaraDataInterface.h"
 #include "VectorVM.h"
 #include "Engine/Font.h"
+#include "NTTFontCache.h"
+#include "NTTFontMetrics.h"
+#include "NTTGlyphBufferRegistry.h"
+#include "NTTTextLayout.h"
+#include "NTTTextLayoutCache.h"
+#include "NTTTextBufferRegistry.h"
+#include "Tasks/Task.h"
+#include <atomic>
 #include "NTTDataInterface.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogNiagaraTextToolkit, Log, All);
@@ -14,91 +22,277 @@ struct FNiagaraDataInterfaceGeneratedFunction;
 struct FNiagaraFunctionSignature;
 struct FVMExternalFunctionBindingInfo;
 
+// Whether text missing from the layout cache is laid out on the tick that picks it up, or on a worker thread
 UENUM(BlueprintType)
-enum class ENTTTextVerticalAlignment : uint8
+enum class ENTTLayoutMode : uint8
 {
-	NTT_TVA_Top		UMETA(DisplayName = "Top"),
-	NTT_TVA_Center	UMETA(DisplayName = "Center"),
-	NTT_TVA_Bottom	UMETA(DisplayName = "Bottom"),
+	// Use the data interface's Async Layout setting
+	NTT_LM_Default	UMETA(DisplayName = "Default"),
+	NTT_LM_Sync		UMETA(DisplayName = "Synchronous"),
+	NTT_LM_Async	UMETA(DisplayName = "Asynchronous"),
 };
 
-UENUM(BlueprintType)
-enum class ENTTTextHorizontalAlignment : uint8
+// The struct used to store our data interface data
+struct FNDIFontUVInfoInstanceData
 {
-	NTT_THA_Left	UMETA(DisplayName = "Left"),
-	NTT_THA_Center	UMETA(DisplayName = "Center"),
-	NTT_THA_Right	UMETA(DisplayName = "Right"),
+	// Shared, immutable glyph data for the font asset (UVs, sprite sizes, vertical offsets, kerning)
+	FNTTGlyphTablePtr GlyphTable;
+	// Per-character, per-line and per-word tables for this instance's text. Immutable and possibly shared with other instances showing the same text.
+	FNTTTextLayoutPtr Layout;
+	bool bFilterWhitespaceCharactersValue = true;
+	// Bumped every time the instance gets a new layout or glyph table, so modules can tell the text changed and respawn
+	uint32 Generation = 0;
+
+	// Serial of the DI content GlyphTable and Layout were built from. Game thread only; not passed to the render thread.
+	uint32 ContentSerial = 0;
+	// Generation last sent to the render thread. Game thread only.
+	uint32 RenderThreadGeneration = MAX_uint32;
+
+	// Numeric fast path. Game thread only; not passed to the render thread.
+	// Serial of the number Layout was built from, 0 while showing InputText
+	uint32 NumberSerial = 0;
+	FNTTNumberText NumberText;
+	// Number glyph metrics for GlyphTable, built on the first number
+	FNTTNumberGlyphs NumberGlyphs;
+
+	// Async layout. Game thread only; not passed to the render thread.
+	// Layout being built on a worker for the current content, and the glyph table it is built against. Both replace GlyphTable and Layout
+	// together once the task completes, so the instance never draws a layout with another font's glyphs.
+	UE::Tasks::TTask<FNTTTextLayoutPtr> PendingLayout;
+	FNTTGlyphTablePtr PendingGlyphTable;
+	// Set when newer content supersedes PendingLayout, so a task that hasn't started yet skips the layout and the cache insert
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> PendingCancelled;
 };
 
-// The struct used to store our data interface data
-struct FNDIFontUVInfoInstanceData
+// What an instance sends the render thread each frame. The glyph table and layout are only filled in when the instance's generation
+// changed since the last frame, so a steady-state frame copies a few words and touches no reference counts.
+struct FNDIFontUVInfoRTData
 {
-	// Normalized per-glyph UVs in texture space: (USize, VSize, UStart, VStart), all in 0-1
-	TArray<FVector4> CharacterTextureUvs;
-	// Per-glyph sprite size in pixels: (Width, Height)
-	TArray<FVector2f> CharacterSpriteSizes;
-	TArray<int32> Unicode;
-	TArray<FVector2f> CharacterPositions;
-	TArray<int32> LineStartIndices;
-	TArray<int32> LineCharacterCounts;
-	TArray<int32> WordStartIndices;
-	TArray<int32> WordCharacterCounts;
-	float TotalTextHeight = 0.0f;
+	FNTTGlyphTablePtr GlyphTable;
+	FNTTTextLayoutPtr Layout;
+	uint32 Generation = 0;
 	bool bFilterWhitespaceCharactersValue = true;
+	bool bContentChanged = false;
+	bool bTextReady = true;
 };
 
 // This proxy is used to safely copy data between game thread and render thread
 struct FNDIFontUVInfoProxy : public FNiagaraDataInterfaceProxy
 {
-	// We manage render-thread buffers explicitly via InitPerInstanceData/UpdateData_RT,
-	// so we don't need Niagara's per-frame GT->RT instance data path.
-	virtual int32 PerInstanceDataPassedToRenderThreadSize() const override { return sizeof(FNDIFontUVInfoInstanceData); }
+	// Only a small header goes through Niagara's per-frame GT->RT instance data path; the buffers themselves are shared through the registries.
+	virtual int32 PerInstanceDataPassedToRenderThreadSize() const override { return sizeof(FNDIFontUVInfoRTData); }
 
 	virtual ~FNDIFontUVInfoProxy() override
 	{
+		for (TPair<FNiagaraSystemInstanceID, FRTInstanceData>& Pair : SystemInstancesToInstanceData_RT)
+		{
+			Pair.Value.Release();
+		}
 		PackedBuffer.Release();
+		DefaultRecordBuffer.Release();
 	}
 
 	FRWBufferStructured PackedBuffer;
+	// Bound in place of the character records of layouts packed without them
+	FRWBufferStructured DefaultRecordBuffer;
 	bool bDefaultInitialized = false;
 
 	struct FRTInstanceData
 	{
-		FRWBufferStructured PackedBuffer;
+		// Per-font glyph data (UVs, sizes, pages), shared with every other instance using the same glyph table
+		FNTTGlyphTablePtr GlyphTable;
+		FShaderResourceViewRHIRef GlyphBufferSRV;
 		uint32 NumRects = 0;
+		uint32 Offset_UVs = 0;
+		uint32 Offset_Sizes = 0;
+		uint32 Offset_Pages = 0;
+
+		// Per-layout text data (glyph indices, positions, lines, words), shared with every other instance using the same cached layout
+		FNTTTextLayoutPtr Layout;
+		FShaderResourceViewRHIRef TextBufferSRV;
+		// Per-character records, only present when the layout was packed with them
+		FShaderResourceViewRHIRef CharacterRecordSRV;
+		uint32 bHasCharacterRecords = 0;
 		uint32 NumChars = 0;
 		uint32 NumLines = 0;
 		uint32 NumWords = 0;
 		uint32 bFilterWhitespaceCharactersValue = 1;
+		uint32 Generation = 0;
+		// 0 while the game thread is laying out new text for this instance asynchronously
+		uint32 bTextReady = 1;
 		float TotalTextHeight = 0.0f;
 		
-		uint32 Offset_UVs = 0;
-		uint32 Offset_Sizes = 0;
-		uint32 Offset_Unicode = 0;
+		uint32 Offset_GlyphIndices = 0;
 		uint32 Offset_Positions = 0;
 		uint32 Offset_LineStart = 0;
 		uint32 Offset_LineCount = 0;
 		uint32 Offset_WordStart = 0;
 		uint32 Offset_WordCount = 0;
+		uint32 Offset_CharacterLines = 0;
+		uint32 Offset_CharacterWords = 0;
+		uint32 Offset_LinePrefixSums = 0;
+		uint32 Offset_WordPrefixSums = 0;
+		uint32 Offset_WordPrefixSumsWithWhitespace = 0;
+
+		// Per-character markup styles, only present when the layout parsed markup
+		uint32 bHasMarkup = 0;
+		uint32 Offset_Colors = 0;
+		uint32 Offset_Scales = 0;
+		uint32 Offset_Styles = 0;
+
+		// Per-character rotations, only present when the layout was bent along a path
+		uint32 bHasRotations = 0;
+		uint32 Offset_Rotations = 0;
+
+		// Line metrics and word bounds, always present
+		uint32 Offset_LineWidths = 0;
+		uint32 Offset_LineTops = 0;
+		uint32 Offset_LineHeights = 0;
+		uint32 Offset_WordBounds = 0;
+		FVector4f TextBounds = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+
+		// Encoding of the text buffer, see FNTTTextBufferRegistry
+		uint32 TextBufferFlags = 0;
+
+		// Points this instance at the shared glyph buffer for InGlyphTable, dropping its reference to the previous one.
+		void SetGlyphTable(FRHICommandListBase& RHICmdList, const FNTTGlyphTablePtr& InGlyphTable)
+		{
+			if (GlyphTable == InGlyphTable)
+			{
+				return;
+			}
 
-		void Release()
+			// Take the new reference before dropping the old one so a table shared by both is never re-uploaded.
+			FShaderResourceViewRHIRef NewGlyphBufferSRV = InGlyphTable.IsValid() ? FNTTGlyphBufferRegistry::Get().AddRef(RHICmdList, InGlyphTable) : nullptr;
+			ReleaseGlyphTable();
+
+			GlyphTable = InGlyphTable;
+			GlyphBufferSRV = NewGlyphBufferSRV;
+
+			NumRects = GlyphTable.IsValid() ? (uint32)GlyphTable->NumGlyphs() : 0;
+			Offset_UVs = FNTTGlyphBufferRegistry::GetUVsOffset(NumRects);
+			Offset_Sizes = FNTTGlyphBufferRegistry::GetSizesOffset(NumRects);
+			Offset_Pages = FNTTGlyphBufferRegistry::GetPagesOffset(NumRects);
+		}
+
+		void ReleaseGlyphTable()
 		{
-			PackedBuffer.Release();
+			if (GlyphTable.IsValid())
+			{
+				FNTTGlyphBufferRegistry::Get().Release(GlyphTable);
+			}
+			GlyphTable.Reset();
+			GlyphBufferSRV.SafeRelease();
 			NumRects = 0;
+			Offset_UVs = 0;
+			Offset_Sizes = 0;
+			Offset_Pages = 0;
+		}
+
+		// Points this instance at the shared text buffer for InLayout, dropping its reference to the previous one.
+		// Called every frame, so an unchanged layout costs a pointer compare.
+		void SetLayout(FRHICommandListBase& RHICmdList, const FNTTTextLayoutPtr& InLayout)
+		{
+			if (Layout == InLayout)
+			{
+				return;
+			}
+
+			// Take the new reference before dropping the old one so a layout shared by both is never re-uploaded.
+			FNTTTextBufferRegistry::FOffsets Offsets;
+			FShaderResourceViewRHIRef NewCharacterRecordSRV;
+			FShaderResourceViewRHIRef NewTextBufferSRV = InLayout.IsValid() ? FNTTTextBufferRegistry::Get().AddRef(RHICmdList, InLayout, GlyphTable.Get(), Offsets, NewCharacterRecordSRV) : nullptr;
+			ReleaseTextData();
+
+			if (!InLayout.IsValid())
+			{
+				return;
+			}
+
+			Layout = InLayout;
+			TextBufferSRV = NewTextBufferSRV;
+			CharacterRecordSRV = NewCharacterRecordSRV;
+			bHasCharacterRecords = CharacterRecordSRV.IsValid() ? 1u : 0u;
+
+			NumChars = (uint32)Layout->Unicode.Num();
+			NumLines = (uint32)Layout->LineStartIndices.Num();
+			NumWords = (uint32)Layout->WordStartIndices.Num();
+			TotalTextHeight = Layout->TotalTextHeight;
+			TextBounds = Layout->TextBounds;
+
+			bHasMarkup = Layout->CharacterColors.Num() > 0 ? 1u : 0u;
+			bHasRotations = Layout->CharacterRotations.Num() > 0 ? 1u : 0u;
+
+			TextBufferFlags = Offsets.Flags;
+			Offset_GlyphIndices = Offsets.GlyphIndices;
+			Offset_Positions = Offsets.Positions;
+			Offset_LineStart = Offsets.LineStart;
+			Offset_LineCount = Offsets.LineCount;
+			Offset_WordStart = Offsets.WordStart;
+			Offset_WordCount = Offsets.WordCount;
+			Offset_CharacterLines = Offsets.CharacterLines;
+			Offset_CharacterWords = Offsets.CharacterWords;
+			Offset_LinePrefixSums = Offsets.LinePrefixSums;
+			Offset_WordPrefixSums = Offsets.WordPrefixSums;
+			Offset_WordPrefixSumsWithWhitespace = Offsets.WordPrefixSumsWithWhitespace;
+			Offset_Colors = Offsets.Colors;
+			Offset_Scales = Offsets.Scales;
+			Offset_Styles = Offsets.Styles;
+			Offset_Rotations = Offsets.Rotations;
+			Offset_LineWidths = Offsets.LineWidths;
+			Offset_LineTops = Offsets.LineTops;
+			Offset_LineHeights = Offsets.LineHeights;
+			Offset_WordBounds = Offsets.WordBounds;
+		}
+
+		void ReleaseTextData()
+		{
+			if (Layout.IsValid())
+			{
+				FNTTTextBufferRegistry::Get().Release(Layout);
+			}
+			Layout.Reset();
+			TextBufferSRV.SafeRelease();
+			CharacterRecordSRV.SafeRelease();
+			bHasCharacterRecords = 0;
 			NumChars = 0;
 			NumLines = 0;
 			NumWords = 0;
-			bFilterWhitespaceCharactersValue = 1;
 			TotalTextHeight = 0.0f;
 		
-			Offset_UVs = 0;
-			Offset_Sizes = 0;
-			Offset_Unicode = 0;
+			Offset_GlyphIndices = 0;
 			Offset_Positions = 0;
 			Offset_LineStart = 0;
 			Offset_LineCount = 0;
 			Offset_WordStart = 0;
 			Offset_WordCount = 0;
+			Offset_CharacterLines = 0;
+			Offset_CharacterWords = 0;
+			Offset_LinePrefixSums = 0;
+			Offset_WordPrefixSums = 0;
+			Offset_WordPrefixSumsWithWhitespace = 0;
+
+			bHasMarkup = 0;
+			Offset_Colors = 0;
+			Offset_Scales = 0;
+			Offset_Styles = 0;
+
+			bHasRotations = 0;
+			Offset_Rotations = 0;
+
+			Offset_LineWidths = 0;
+			Offset_LineTops = 0;
+			Offset_LineHeights = 0;
+			Offset_WordBounds = 0;
+			TextBounds = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+
+			TextBufferFlags = 0;
+		}
+
+		void Release()
+		{
+			ReleaseGlyphTable();
+			ReleaseTextData();
 		}
 	};
 
@@ -111,6 +305,11 @@ struct FNDIFontUVInfoProxy : public FNiagaraDataInterfaceProxy
 			void* Dest = RHICmdList.LockBuffer(PackedBuffer.Buffer, 0, sizeof(float) * 4, RLM_WriteOnly);
 			FMemory::Memcpy(Dest, &Zeros, sizeof(float) * 4);
 			RHICmdList.UnlockBuffer(PackedBuffer.Buffer);
+
+			DefaultRecordBuffer.Initialize(RHICmdList, TEXT("NTT_CharacterRecords_Default"), sizeof(FUintVector4), 1, BUF_ShaderResource | BUF_Static);
+			void* DestRecord = RHICmdList.LockBuffer(DefaultRecordBuffer.Buffer, 0, sizeof(FUintVector4), RLM_WriteOnly);
+			FMemory::Memzero(DestRecord, sizeof(FUintVector4));
+			RHICmdList.UnlockBuffer(DefaultRecordBuffer.Buffer);
 			bDefaultInitialized = true;
 		}
 	}
@@ -118,160 +317,53 @@ struct FNDIFontUVInfoProxy : public FNiagaraDataInterfaceProxy
 	static void ProvidePerInstanceDataForRenderThread(void* InDataForRenderThread, void* InDataFromGameThread, const FNiagaraSystemInstanceID& SystemInstance)
 	{
 		// Initialize the render thread instance data into the pre-allocated memory
-		FNDIFontUVInfoInstanceData* DataForRenderThread = new (InDataForRenderThread) FNDIFontUVInfoInstanceData();
+		FNDIFontUVInfoRTData* DataForRenderThread = new (InDataForRenderThread) FNDIFontUVInfoRTData();
 
-		// Copy the game thread data
-		const FNDIFontUVInfoInstanceData* DataFromGameThread = static_cast<const FNDIFontUVInfoInstanceData*>(InDataFromGameThread);
-		*DataForRenderThread = *DataFromGameThread;
+		FNDIFontUVInfoInstanceData* DataFromGameThread = static_cast<FNDIFontUVInfoInstanceData*>(InDataFromGameThread);
+		DataForRenderThread->Generation = DataFromGameThread->Generation;
+		DataForRenderThread->bFilterWhitespaceCharactersValue = DataFromGameThread->bFilterWhitespaceCharactersValue;
+		DataForRenderThread->bTextReady = !DataFromGameThread->PendingLayout.IsValid();
 
-		UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT DI (RT): ProvidePerInstanceDataForRenderThread - InstanceID=%llu, CharacterTextureUvs.Num=%d"),
-			(uint64)SystemInstance, DataForRenderThread->CharacterTextureUvs.Num());
+		// The render thread keeps what it was last sent, so the shared data only goes over when the instance changed it.
+		if (DataFromGameThread->RenderThreadGeneration != DataFromGameThread->Generation)
+		{
+			DataForRenderThread->GlyphTable = DataFromGameThread->GlyphTable;
+			DataForRenderThread->Layout = DataFromGameThread->Layout;
+			DataForRenderThread->bContentChanged = true;
+			DataFromGameThread->RenderThreadGeneration = DataFromGameThread->Generation;
+
+			UE_LOG(LogNiagaraTextToolkit, Verbose, TEXT("NTT DI (RT): ProvidePerInstanceDataForRenderThread - InstanceID=%llu, Generation=%u"),
+				(uint64)SystemInstance, DataForRenderThread->Generation);
+		}
 	}
 
-	void UpdateData_RT(FNDIFontUVInfoInstanceData* InstanceDataFromGT, const FNiagaraSystemInstanceID& InstanceID, FRHICommandListBase& RHICmdList)
+	void UpdateData_RT(const FNDIFontUVInfoRTData& DataFromGT, const FNiagaraSystemInstanceID& InstanceID, FRHICommandListBase& RHICmdList)
 	{
 		FRTInstanceData& RTInstance = SystemInstancesToInstanceData_RT.FindOrAdd(InstanceID);
 
-		// Release old data first. This resets all counts and offsets to 0.
-		RTInstance.Release();
-
-		// Calculate sizes
-		const int32 NumRects = InstanceDataFromGT->CharacterTextureUvs.Num();
-		const int32 NumChars = InstanceDataFromGT->Unicode.Num();
-		const int32 NumLines = InstanceDataFromGT->LineStartIndices.Num();
-		const int32 NumWords = InstanceDataFromGT->WordStartIndices.Num();
-
-		RTInstance.NumRects = (uint32)NumRects;
-		RTInstance.NumChars = (uint32)NumChars;
-		RTInstance.NumLines = (uint32)NumLines;
-		RTInstance.NumWords = (uint32)NumWords;
-		RTInstance.bFilterWhitespaceCharactersValue = InstanceDataFromGT->bFilterWhitespaceCharactersValue ? 1u : 0u;
-		RTInstance.TotalTextHeight = InstanceDataFromGT->TotalTextHeight;
-
-		// Calculate offsets (in floats) directly into the struct
-		RTInstance.Offset_UVs = 0;
-		uint32 CurrentOffset = RTInstance.Offset_UVs + NumRects * 4;
-
-		RTInstance.Offset_Sizes = CurrentOffset;
-		CurrentOffset += NumRects * 2;
-
-		RTInstance.Offset_Unicode = CurrentOffset;
-		CurrentOffset += NumChars * 1;
-
-		RTInstance.Offset_Positions = CurrentOffset;
-		CurrentOffset += NumChars * 2;
-
-		RTInstance.Offset_LineStart = CurrentOffset;
-		CurrentOffset += NumLines * 1;
-
-		RTInstance.Offset_LineCount = CurrentOffset;
-		CurrentOffset += NumLines * 1;
-
-		RTInstance.Offset_WordStart = CurrentOffset;
-		CurrentOffset += NumWords * 1;
-
-		RTInstance.Offset_WordCount = CurrentOffset;
-		CurrentOffset += NumWords * 1;
-
-		const uint32 TotalFloats = FMath::Max(CurrentOffset, 1u);
-
-		// Initialize buffer
-		RTInstance.PackedBuffer.Initialize(RHICmdList, TEXT("NTT_PackedBuffer"), sizeof(float), TotalFloats, BUF_ShaderResource | BUF_Static);
-
-		float* DestInfo = (float*)RHICmdList.LockBuffer(RTInstance.PackedBuffer.Buffer, 0, TotalFloats * sizeof(float), RLM_WriteOnly);
-
-		// Helper to safely write data
-		if (TotalFloats == 1 && CurrentOffset == 0)
-		{
-			DestInfo[0] = 0.0f;
-		}
-		else
+		if (DataFromGT.bContentChanged)
 		{
-			// UVs (float4)
-			for (int32 i = 0; i < NumRects; ++i)
-			{
-				const FVector4& Src = InstanceDataFromGT->CharacterTextureUvs[i];
-				int32 Base = RTInstance.Offset_UVs + i * 4;
-				DestInfo[Base + 0] = (float)Src.X;
-				DestInfo[Base + 1] = (float)Src.Y;
-				DestInfo[Base + 2] = (float)Src.Z;
-				DestInfo[Base + 3] = (float)Src.W;
-			}
+			// The glyph buffer is shared per font and only changes when the instance switches fonts.
+			RTInstance.SetGlyphTable(RHICmdList, DataFromGT.GlyphTable);
 
-			// Sizes (float2)
-			for (int32 i = 0; i < NumRects; ++i)
-			{
-				const FVector2f& Src = InstanceDataFromGT->CharacterSpriteSizes[i];
-				int32 Base = RTInstance.Offset_Sizes + i * 2;
-				DestInfo[Base + 0] = Src.X;
-				DestInfo[Base + 1] = Src.Y;
-			}
-
-			// Unicode (int32 -> asfloat)
-			for (int32 i = 0; i < NumChars; ++i)
-			{
-				int32 Src = InstanceDataFromGT->Unicode[i];
-				int32 Base = RTInstance.Offset_Unicode + i;
-				FMemory::Memcpy(&DestInfo[Base], &Src, sizeof(int32));
-			}
-
-			// Positions (float2)
-			for (int32 i = 0; i < NumChars; ++i)
-			{
-				const FVector2f& Src = InstanceDataFromGT->CharacterPositions[i];
-				int32 Base = RTInstance.Offset_Positions + i * 2;
-				DestInfo[Base + 0] = Src.X;
-				DestInfo[Base + 1] = Src.Y;
-			}
-
-			// LineStartIndices (int32)
-			for (int32 i = 0; i < NumLines; ++i)
-			{
-				int32 Src = InstanceDataFromGT->LineStartIndices[i];
-				int32 Base = RTInstance.Offset_LineStart + i;
-				FMemory::Memcpy(&DestInfo[Base], &Src, sizeof(int32));
-			}
-
-			// LineCharacterCounts (int32)
-			for (int32 i = 0; i < NumLines; ++i)
-			{
-				int32 Src = InstanceDataFromGT->LineCharacterCounts[i];
-				int32 Base = RTInstance.Offset_LineCount + i;
-				FMemory::Memcpy(&DestInfo[Base], &Src, sizeof(int32));
-			}
-
-			// WordStartIndices (int32)
-			for (int32 i = 0; i < NumWords; ++i)
-			{
-				int32 Src = InstanceDataFromGT->WordStartIndices[i];
-				int32 Base = RTInstance.Offset_WordStart + i;
-				FMemory::Memcpy(&DestInfo[Base], &Src, sizeof(int32));
-			}
-
-			// WordCharacterCounts (int32)
-			for (int32 i = 0; i < NumWords; ++i)
-			{
-				int32 Src = InstanceDataFromGT->WordCharacterCounts[i];
-				int32 Base = RTInstance.Offset_WordCount + i;
-				FMemory::Memcpy(&DestInfo[Base], &Src, sizeof(int32));
-			}
+			// The text buffer is shared per layout and only changes when the instance gets a new layout.
+			// Set after the glyph table, which a layout packed here needs for its character records.
+			RTInstance.SetLayout(RHICmdList, DataFromGT.Layout);
 		}
-
-		RHICmdList.UnlockBuffer(RTInstance.PackedBuffer.Buffer);
+		RTInstance.bFilterWhitespaceCharactersValue = DataFromGT.bFilterWhitespaceCharactersValue ? 1u : 0u;
+		RTInstance.Generation = DataFromGT.Generation;
+		RTInstance.bTextReady = DataFromGT.bTextReady ? 1u : 0u;
 	}
 
 	virtual void ConsumePerInstanceDataFromGameThread(void* PerInstanceData, const FNiagaraSystemInstanceID& InstanceID) override
 	{
-		UE_LOG(LogNiagaraTextToolkit, Log, TEXT("NTT DI Proxy: ConsumePerInstanceDataFromGameThread - Proxy=%p, InstanceID=%llu"), 
-			this, (uint64)InstanceID);
-
-		FNDIFontUVInfoInstanceData* InstanceDataFromGT = static_cast<FNDIFontUVInfoInstanceData*>(PerInstanceData);
+		FNDIFontUVInfoRTData* DataFromGT = static_cast<FNDIFontUVInfoRTData*>(PerInstanceData);
 		FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
 
-		UpdateData_RT(InstanceDataFromGT, InstanceID, RHICmdList);
+		UpdateData_RT(*DataFromGT, InstanceID, RHICmdList);
 
 		// Call the destructor to clean up the GT data
-		InstanceDataFromGT->~FNDIFontUVInfoInstanceData();
+		DataFromGT->~FNDIFontUVInfoRTData();
 	}
 
 	TMap<FNiagaraSystemInstanceID, FRTInstanceData> SystemInstancesToInstanceData_RT;
@@ -284,52 +376,115 @@ class NIAGARATEXTTOOLKIT_API UNTTDataInterface : public UNiagaraDataInterface
 
 public:
 	BEGIN_SHADER_PARAMETER_STRUCT(FShaderParameters, )
+		SHADER_PARAMETER_SRV(StructuredBuffer<float>, GlyphBuffer)
 		SHADER_PARAMETER_SRV(StructuredBuffer<float>, PackedBuffer)
+		SHADER_PARAMETER_SRV(StructuredBuffer<uint4>, CharacterRecords)
 
 		SHADER_PARAMETER(uint32, Offset_UVs)
 		SHADER_PARAMETER(uint32, Offset_Sizes)
-		SHADER_PARAMETER(uint32, Offset_Unicode)
+		SHADER_PARAMETER(uint32, Offset_Pages)
+		SHADER_PARAMETER(uint32, Offset_GlyphIndices)
 		SHADER_PARAMETER(uint32, Offset_Positions)
 		SHADER_PARAMETER(uint32, Offset_LineStart)
 		SHADER_PARAMETER(uint32, Offset_LineCount)
 		SHADER_PARAMETER(uint32, Offset_WordStart)
 		SHADER_PARAMETER(uint32, Offset_WordCount)
+		SHADER_PARAMETER(uint32, Offset_CharacterLines)
+		SHADER_PARAMETER(uint32, Offset_CharacterWords)
+		SHADER_PARAMETER(uint32, Offset_LinePrefixSums)
+		SHADER_PARAMETER(uint32, Offset_WordPrefixSums)
+		SHADER_PARAMETER(uint32, Offset_WordPrefixSumsWithWhitespace)
+		SHADER_PARAMETER(uint32, Offset_Colors)
+		SHADER_PARAMETER(uint32, Offset_Scales)
+		SHADER_PARAMETER(uint32, Offset_Styles)
+		SHADER_PARAMETER(uint32, Offset_Rotations)
+		SHADER_PARAMETER(uint32, Offset_LineWidths)
+		SHADER_PARAMETER(uint32, Offset_LineTops)
+		SHADER_PARAMETER(uint32, Offset_LineHeights)
+		SHADER_PARAMETER(uint32, Offset_WordBounds)
 
 		SHADER_PARAMETER(uint32, NumRects)
 		SHADER_PARAMETER(uint32, NumChars)
 		SHADER_PARAMETER(uint32, NumLines)
 		SHADER_PARAMETER(uint32, NumWords)
 		SHADER_PARAMETER(uint32, bFilterWhitespaceCharactersValue)
+		SHADER_PARAMETER(uint32, bHasMarkup)
+		SHADER_PARAMETER(uint32, bHasRotations)
+		SHADER_PARAMETER(uint32, bHasCharacterRecords)
+		SHADER_PARAMETER(uint32, TextBufferFlags)
+		SHADER_PARAMETER(uint32, Generation)
+		SHADER_PARAMETER(uint32, bTextReady)
 		SHADER_PARAMETER(float, TotalTextHeight)
+		SHADER_PARAMETER(FVector4f, TextBounds)
 	END_SHADER_PARAMETER_STRUCT()
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (DisplayName = "Font Asset"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetFont, meta = (DisplayName = "Font Asset"))
 	UFont* FontAsset = nullptr;
 
+	// Optional glyph metrics baked from a font in the editor. When set, these are used instead of converting Font Asset at runtime.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetFontMetrics, meta = (DisplayName = "Font Metrics"))
+	UNTTFontMetrics* FontMetrics = nullptr;
+
 	// The input text to compute character positions for; converted to Unicode and character positions per instance
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (DisplayName = "Input Text", MultiLine = "true"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetInputText, meta = (DisplayName = "Input Text", MultiLine = "true"))
 	FString InputText;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, meta = (DisplayName = "Horizontal Alignment"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetHorizontalAlignment, AdvancedDisplay, meta = (DisplayName = "Horizontal Alignment"))
 	ENTTTextHorizontalAlignment HorizontalAlignment = ENTTTextHorizontalAlignment::NTT_THA_Center;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, meta = (DisplayName = "Vertical Alignment"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetVerticalAlignment, AdvancedDisplay, meta = (DisplayName = "Vertical Alignment"))
 	ENTTTextVerticalAlignment VerticalAlignment = ENTTTextVerticalAlignment::NTT_TVA_Center;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, meta = (DisplayName = "Vertical Offset"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetVerticalOffset, AdvancedDisplay, meta = (DisplayName = "Vertical Offset"))
 	float VerticalOffset = 0.0f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, meta = (DisplayName = "Kerning Offset"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetKerningOffset, AdvancedDisplay, meta = (DisplayName = "Kerning Offset"))
 	float KerningOffset = 0.0f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, meta = (DisplayName = "Whitespace Width Multiplier"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetWhitespaceWidthMultiplier, AdvancedDisplay, meta = (DisplayName = "Whitespace Width Multiplier"))
 	float WhitespaceWidthMultiplier = 1.0f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, meta = (DisplayName = "Filter Whitespace Characters"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetFilterWhitespaceCharacters, AdvancedDisplay, meta = (DisplayName = "Filter Whitespace Characters"))
 	bool bFilterWhitespaceCharacters = true;
 
+	// Wraps lines at word boundaries so they fit within this width, in pixels. Words wider than the limit are kept on their own line. 0 disables wrapping.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetMaxLineWidth, AdvancedDisplay, meta = (DisplayName = "Max Line Width", ClampMin = "0.0"))
+	float MaxLineWidth = 0.0f;
+
+	// Parses inline tags in the text: <c=#RRGGBB[AA]>color</c>, <s=1.5>scale</s> and <style=Name>style</style>. Tags can nest and aren't drawn.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetParseMarkup, AdvancedDisplay, meta = (DisplayName = "Parse Markup"))
+	bool bParseMarkup = false;
+
+	// Style names usable in <style=Name> tags. Get Character Style returns the index of the name in this list.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetMarkupStyles, AdvancedDisplay, meta = (DisplayName = "Markup Styles", EditCondition = "bParseMarkup"))
+	TArray<FName> MarkupStyles;
+
+	// Bends the text along an arc or a path. Character positions and rotations are baked at layout time; read them with Get Character Transform.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetPathMode, AdvancedDisplay, meta = (DisplayName = "Path Mode"))
+	ENTTTextPathMode PathMode = ENTTTextPathMode::NTT_TPM_None;
+
+	// Arc radius in pixels. Positive values curve the text around a center below it, negative values around a center above it.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetArcRadius, AdvancedDisplay, meta = (DisplayName = "Arc Radius", EditCondition = "PathMode == ENTTTextPathMode::NTT_TPM_Arc"))
+	float ArcRadius = 500.0f;
+
+	// Rotates the text around the arc's center, in degrees
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetArcStartAngle, AdvancedDisplay, meta = (DisplayName = "Arc Start Angle", EditCondition = "PathMode == ENTTTextPathMode::NTT_TPM_Arc"))
+	float ArcStartAngle = 0.0f;
+
+	// Points of the path in text space (pixels, +X right, +Y down). Set from a spline with Set Niagara Variable (NTT Path From Spline).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetPathPoints, AdvancedDisplay, meta = (DisplayName = "Path Points", EditCondition = "PathMode == ENTTTextPathMode::NTT_TPM_Path"))
+	TArray<FVector2D> PathPoints;
+
+	// Lays out text that isn't already cached on a worker thread instead of on the tick that picks it up, so long texts don't hitch the frame they spawn.
+	// Until the layout is ready an instance keeps showing its previous text, or no characters when it has none; Is Text Ready reports when it swaps.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetAsyncLayout, AdvancedDisplay, meta = (DisplayName = "Async Layout"))
+	bool bAsyncLayout = false;
+
 	//UObject Interface
 	virtual void PostInitProperties() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 	//UObject Interface End
 
 	//UNiagaraDataInterface Interface
@@ -347,6 +502,8 @@ public:
 	virtual bool Equals(const UNiagaraDataInterface* Other) const override;
 	virtual bool InitPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance) override;
 	virtual void DestroyPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance) override;
+	virtual bool PerInstanceTick(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance, float DeltaSeconds) override;
+	virtual bool HasPreSimulateTick() const override { return true; }
 	virtual int32 PerInstanceDataSize() const override;
 	virtual void ProvidePerInstanceDataForRenderThread(void* DataForRenderThread, void* PerInstanceData, const FNiagaraSystemInstanceID& SystemInstance) override;
 	//UNiagaraDataInterface Interface
@@ -364,6 +521,77 @@ public:
 	void GetCharacterCountInLineRangeVM(FVectorVMExternalFunctionContext& Context);
 	void GetCharacterSpriteSizeVM(FVectorVMExternalFunctionContext& Context);
 	void GetTextHeightVM(FVectorVMExternalFunctionContext& Context);
+	void GetCharacterPageVM(FVectorVMExternalFunctionContext& Context);
+	void GetCharacterColorVM(FVectorVMExternalFunctionContext& Context);
+	void GetCharacterScaleVM(FVectorVMExternalFunctionContext& Context);
+	void GetCharacterStyleVM(FVectorVMExternalFunctionContext& Context);
+	void GetCharacterLineIndexVM(FVectorVMExternalFunctionContext& Context);
+	void GetCharacterWordIndexVM(FVectorVMExternalFunctionContext& Context);
+	void GetCharacterTransformVM(FVectorVMExternalFunctionContext& Context);
+	void GetLineWidthVM(FVectorVMExternalFunctionContext& Context);
+	void GetLineTopVM(FVectorVMExternalFunctionContext& Context);
+	void GetWordBoundsVM(FVectorVMExternalFunctionContext& Context);
+	void GetTextBoundsVM(FVectorVMExternalFunctionContext& Context);
+	void GetTextGenerationVM(FVectorVMExternalFunctionContext& Context);
+	void GetCharacterRecordVM(FVectorVMExternalFunctionContext& Context);
+	void IsTextReadyVM(FVectorVMExternalFunctionContext& Context);
+
+	// Layout settings gathered from the properties above
+	FNTTTextLayoutSettings GetLayoutSettings() const;
+
+	// Must be called after changing InputText, the font or a layout property from code (the NTT helper functions do this).
+	// Running instances lay the text out again on their next tick, without reinitializing the system.
+	void InvalidateContent();
+
+	// Change the text, font or path of every running instance on its next tick, without reinitializing the system and losing its particles.
+	// Safe to call while instances tick on worker threads, unlike writing the properties directly.
+	// LayoutMode overrides Async Layout for this text only.
+	void SetText(const FString& Text, ENTTLayoutMode LayoutMode = ENTTLayoutMode::NTT_LM_Default);
+	void SetPath(TArray<FVector2D>&& Points, ENTTTextPathMode Mode);
+
+	// Blueprint setters of the properties above, so that writing them from Blueprint also reaches running instances on their next tick.
+	UFUNCTION(BlueprintSetter)
+	void SetFont(UFont* Font);
+	UFUNCTION(BlueprintSetter)
+	void SetFontMetrics(UNTTFontMetrics* InFontMetrics);
+	UFUNCTION(BlueprintSetter)
+	void SetInputText(const FString& Text);
+	UFUNCTION(BlueprintSetter)
+	void SetHorizontalAlignment(ENTTTextHorizontalAlignment Alignment);
+	UFUNCTION(BlueprintSetter)
+	void SetVerticalAlignment(ENTTTextVerticalAlignment Alignment);
+	UFUNCTION(BlueprintSetter)
+	void SetVerticalOffset(float Offset);
+	UFUNCTION(BlueprintSetter)
+	void SetKerningOffset(float Offset);
+	UFUNCTION(BlueprintSetter)
+	void SetWhitespaceWidthMultiplier(float Multiplier);
+	UFUNCTION(BlueprintSetter)
+	void SetFilterWhitespaceCharacters(bool bFilter);
+	UFUNCTION(BlueprintSetter)
+	void SetMaxLineWidth(float Width);
+	UFUNCTION(BlueprintSetter)
+	void SetParseMarkup(bool bParse);
+	UFUNCTION(BlueprintSetter)
+	void SetMarkupStyles(const TArray<FName>& Styles);
+	UFUNCTION(BlueprintSetter)
+	void SetPathMode(ENTTTextPathMode Mode);
+	UFUNCTION(BlueprintSetter)
+	void SetArcRadius(float Radius);
+	UFUNCTION(BlueprintSetter)
+	void SetArcStartAngle(float Angle);
+	UFUNCTION(BlueprintSetter)
+	void SetPathPoints(const TArray<FVector2D>& Points);
+	UFUNCTION(BlueprintSetter)
+	void SetAsyncLayout(bool bAsync);
+
+	// Shows Value instead of InputText. The number is formatted without building an FString and laid out from cached digit metrics
+	// by every running instance on its next tick, without reinitializing the system. A value that formats the same as the one shown costs nothing.
+	void SetNumber(int64 Value, const FNTTNumberFormat& Format = FNTTNumberFormat());
+	void SetFloatNumber(double Value, const FNTTNumberFormat& Format = FNTTNumberFormat());
+
+	// Goes back to showing InputText. Running instances switch on their next tick.
+	void ClearNumber();
 
 	/** Returns the render thread proxy for this data interface. */
 	FNDIFontUVInfoProxy* GetFontProxy() const { return static_cast<FNDIFontUVInfoProxy*>(Proxy.Get()); }
@@ -382,23 +610,54 @@ private:
 	static const FName GetCharacterCountInLineRangeName;
 	static const FName GetCharacterSpriteSizeName;
 	static const FName GetTextHeightName;
-
-	// Computes per-character positions in local text space using per-glyph sprite sizes in pixels.
-	static TArray<FVector2f> GetCharacterPositions(const TArray<FVector2f>& CharacterSpriteSizes, const TArray<int32>& VerticalOffsets, int32 Kerning, float ExtraVerticalOffset, float ExtraKerningOffset, float WhitespaceWidthMultiplier, FString InputString, ENTTTextHorizontalAlignment XAlignment, ENTTTextVerticalAlignment YAlignment, float& OutTotalHeight);
-
-	// Extracts per-glyph sprite sizes (pixels), normalized texture UVs, vertical offsets, and global kerning from the font asset.
-	static bool GetFontInfo(const UFont* FontAsset, TArray<FVector4>& OutCharacterTextureUvs, TArray<FVector2f>& OutCharacterSpriteSizes, TArray<int32>& OutVerticalOffsets, int32& OutKerning);
-
-	static void ProcessText(
-		const FString& InputText,
-		const TArray<FVector2f>& CharacterPositionsUnfiltered,
-		const bool bFilterWhitespace,
-		TArray<int32>& OutUnicode,
-		TArray<FVector2f>& OutCharacterPositions,
-		TArray<int32>& OutLineStartIndices,
-		TArray<int32>& OutLineCharacterCounts,
-		TArray<int32>& OutWordStartIndices,
-		TArray<int32>& OutWordCharacterCounts
-	);
-
+	static const FName GetCharacterPageName;
+	static const FName GetCharacterColorName;
+	static const FName GetCharacterScaleName;
+	static const FName GetCharacterStyleName;
+	static const FName GetCharacterLineIndexName;
+	static const FName GetCharacterWordIndexName;
+	static const FName GetCharacterTransformName;
+	static const FName GetLineWidthName;
+	static const FName GetLineTopName;
+	static const FName GetWordBoundsName;
+	static const FName GetTextBoundsName;
+	static const FName GetTextGenerationName;
+	static const FName GetCharacterRecordName;
+	static const FName IsTextReadyName;
+
+	// Layout used by the last destroyed instance. When the system is reinitialized, on a cache miss the next
+	// InitPerInstanceData starts from a copy of this and only relays out the lines from the first edit onward.
+	FCriticalSection RetainedLayoutLock;
+	FNTTGlyphTablePtr RetainedGlyphTable;
+	FNTTTextLayoutPtr RetainedLayout;
+
+	void SetNumberText(const FNTTNumberText& Number);
+
+	// Rebuilds InstanceData's glyph table and layout from the current properties, keeping whatever didn't change.
+	// With async layout a cache miss is laid out on a worker instead, and picked up by FinishPendingLayout.
+	void UpdateContent(FNDIFontUVInfoInstanceData& InstanceData);
+
+	// Writes Property under ContentLock and has running instances pick the change up
+	template<typename T>
+	void SetContentProperty(T& Property, const T& Value);
+
+	// Swaps in InstanceData's completed async layout
+	void FinishPendingLayout(FNDIFontUVInfoInstanceData& InstanceData);
+
+	// Serial of the text, font and layout properties, bumped by InvalidateContent and picked up by each instance in PerInstanceTick.
+	// ContentLock guards those properties while instances read them, since instances can tick on worker threads.
+	mutable FCriticalSection ContentLock;
+	std::atomic<uint32> ContentSerial{ 1 };
+	// Layout mode passed with the last SetText, and the content serial it applies to. Any later change goes back to bAsyncLayout.
+	ENTTLayoutMode ContentLayoutMode = ENTTLayoutMode::NTT_LM_Default;
+	uint32 ContentLayoutModeSerial = 0;
+
+	// Lays out the current number into InstanceData if it changed since the instance last saw it
+	void UpdateNumberLayout(FNDIFontUVInfoInstanceData& InstanceData);
+
+	// Numeric fast path state, written by SetNumber and picked up by each instance in PerInstanceTick.
+	// NumberSerial is bumped under NumberLock on every SetNumber; 0 means InputText is shown.
+	mutable FCriticalSection NumberLock;
+	FNTTNumberText NumberText;
+	std::atomic<uint32> NumberSerial{ 0 };
 };
@@ -0,0 +1,99 @@
+// Property of Lucian Tranc
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UFont;
+
+// Immutable glyph data extracted from a font asset. Built once per font and shared by every NTT data interface instance using that font.
+// Glyph arrays are compact (one entry per glyph the font actually has) and are addressed through a two-level page table keyed by codepoint.
+struct NIAGARATEXTTOOLKIT_API FNTTGlyphTable
+{
+	// Codepoints are split into a high byte (page) and a low byte (slot within the page)
+	static constexpr int32 CodepointPageBits = 8;
+	static constexpr int32 CodepointPageSize = 1 << CodepointPageBits;
+	static constexpr int32 NumCodepointPages = 0x10000 >> CodepointPageBits;
+
+	// Codepoint of each glyph
+	TArray<int32> GlyphCodepoints;
+	// Normalized per-glyph UVs in the glyph's own texture page: (USize, VSize, UStart, VStart), all in 0-1
+	TArray<FVector4f> CharacterTextureUvs;
+	// Per-glyph sprite size in pixels: (Width, Height)
+	TArray<FVector2f> CharacterSpriteSizes;
+	// Per-glyph offset from the line's origin to the top of the glyph, in pixels
+	TArray<int32> VerticalOffsets;
+	// Per-glyph index of the font texture page the glyph is stored on
+	TArray<int32> GlyphTexturePages;
+	int32 NumTexturePages = 0;
+	int32 Kerning = 0;
+	// Height of the tallest glyph, used as the fallback height for lines with no drawable characters
+	float MaxGlyphHeight = 0.0f;
+
+	// First level: one entry per codepoint page, holding the page's offset into CodepointPages or INDEX_NONE if the page has no glyphs
+	TArray<int32> CodepointPageOffsets;
+	// Second level: CodepointPageSize glyph indices per populated page, INDEX_NONE for codepoints the font doesn't have
+	TArray<int32> CodepointPages;
+
+	// Returns the glyph index for Codepoint, or INDEX_NONE if the font has no glyph for it
+	FORCEINLINE int32 FindGlyphIndex(int32 Codepoint) const
+	{
+		const int32 Page = Codepoint >> CodepointPageBits;
+		if (Codepoint < 0 || !CodepointPageOffsets.IsValidIndex(Page))
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 PageOffset = CodepointPageOffsets[Page];
+		return PageOffset != INDEX_NONE ? CodepointPages[PageOffset + (Codepoint & (CodepointPageSize - 1))] : INDEX_NONE;
+	}
+
+	int32 NumGlyphs() const { return CharacterSpriteSizes.Num(); }
+
+	// Adds a glyph for Codepoint and registers it in the page table. Returns the new glyph index.
+	int32 AddGlyph(int32 Codepoint, const FVector4f& TextureUv, const FVector2f& SpriteSize, int32 VerticalOffset, int32 TexturePage);
+
+	// Serializes every array as flat bulk data so baked tables load with a straight memory read.
+	void Serialize(FArchive& Ar);
+};
+
+typedef TSharedPtr<const FNTTGlyphTable, ESPMode::ThreadSafe> FNTTGlyphTablePtr;
+
+// Process-wide cache of glyph tables keyed by font asset.
+// Entries are dropped when the font is garbage collected or edited/reimported; instances holding an old table keep it alive until they are destroyed.
+class NIAGARATEXTTOOLKIT_API FNTTFontCache
+{
+public:
+	static FNTTFontCache& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	// Returns the shared glyph table for FontAsset, building it on first use.
+	// On failure OutGlyphTable is set to an empty table and false is returned.
+	bool FindOrAdd(const UFont* FontAsset, FNTTGlyphTablePtr& OutGlyphTable);
+
+	// Drops the cached table for FontAsset so the next FindOrAdd rebuilds it.
+	void Invalidate(const UFont* FontAsset);
+
+	const FNTTGlyphTablePtr& GetEmptyGlyphTable() const { return EmptyGlyphTable; }
+
+	// Extracts per-glyph sprite sizes (pixels), normalized texture UVs, vertical offsets, and global kerning from the font asset.
+	static bool BuildGlyphTable(const UFont* FontAsset, FNTTGlyphTable& OutGlyphTable);
+
+private:
+	FNTTFontCache();
+
+	void OnPostGarbageCollect();
+#if WITH_EDITOR
+	void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+#endif
+
+	FCriticalSection CacheLock;
+	TMap<TObjectKey<UFont>, FNTTGlyphTablePtr> GlyphTables;
+	FNTTGlyphTablePtr EmptyGlyphTable;
+
+	FDelegateHandle PostGarbageCollectHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+};
@@ -0,0 +1,45 @@
+// Property of Lucian Tranc
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "NTTFontCache.h"
+#include "NTTFontMetrics.generated.h"
+
+class UFont;
+
+// Glyph metrics baked from an offline font in the editor (see UNiagaraTextToolkitEditorHelpers::BakeFontMetricsToAsset).
+// Stores the same flat glyph table the data interface builds from a UFont, so assigning one skips the font conversion at runtime.
+UCLASS(BlueprintType, Category = "Niagara Text Toolkit Plugin", meta = (DisplayName = "NTT Font Metrics"))
+class NIAGARATEXTTOOLKIT_API UNTTFontMetrics : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+#if WITH_EDITORONLY_DATA
+	// The font these metrics were baked from
+	UPROPERTY(VisibleAnywhere, Category = "Font Metrics")
+	TSoftObjectPtr<UFont> SourceFont;
+#endif
+
+	// Number of glyphs in the baked table
+	UPROPERTY(VisibleAnywhere, Category = "Font Metrics")
+	int32 NumGlyphs = 0;
+
+	// Number of texture pages the baked glyphs are spread across
+	UPROPERTY(VisibleAnywhere, Category = "Font Metrics")
+	int32 NumTexturePages = 0;
+
+	//UObject Interface
+	virtual void Serialize(FArchive& Ar) override;
+	//UObject Interface End
+
+	// Replaces the baked glyph table. Instances already using the previous table keep it until they are reinitialized.
+	void SetGlyphTable(FNTTGlyphTable&& InGlyphTable);
+
+	FNTTGlyphTablePtr GetGlyphTable() const { return GlyphTable; }
+
+private:
+	TSharedPtr<FNTTGlyphTable, ESPMode::ThreadSafe> GlyphTable;
+};
@@ -0,0 +1,38 @@
+// Property of Lucian Tranc
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderResource.h"
+#include "NTTFontCache.h"
+
+// Render-thread registry of GPU glyph buffers, one per glyph table.
+// Every NTT instance using the same font binds the same buffer, so the font's glyph data is uploaded once instead of once per instance.
+//
+// Buffer layout (in floats): UV rects (float4) for every glyph, then sprite sizes (float2), then texture pages (int as float bits).
+class NIAGARATEXTTOOLKIT_API FNTTGlyphBufferRegistry
+{
+public:
+	static FNTTGlyphBufferRegistry& Get();
+
+	static uint32 GetUVsOffset(uint32 NumGlyphs) { return 0; }
+	static uint32 GetSizesOffset(uint32 NumGlyphs) { return NumGlyphs * 4; }
+	static uint32 GetPagesOffset(uint32 NumGlyphs) { return NumGlyphs * 6; }
+
+	// Adds a reference to the buffer for GlyphTable, creating and uploading it on first use. Render thread only.
+	FShaderResourceViewRHIRef AddRef(FRHICommandListBase& RHICmdList, const FNTTGlyphTablePtr& GlyphTable);
+
+	// Drops a reference added by AddRef. The buffer is released once no instance references it. Render thread only.
+	void Release(const FNTTGlyphTablePtr& GlyphTable);
+
+private:
+	struct FEntry
+	{
+		// Keeps the table (and therefore the map key) alive while the buffer exists
+		FNTTGlyphTablePtr GlyphTable;
+		FRWBufferStructured Buffer;
+		int32 RefCount = 0;
+	};
+
+	TMap<const FNTTGlyphTable*, FEntry> Entries;
+};
@@ -0,0 +1,122 @@
+// Property of Lucian Tranc
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderResource.h"
+#include "NTTTextLayout.h"
+
+// Everything a GPU module usually fetches for one character, packed into two uint4s.
+// Mirrored by the CharacterRecords reads in NTTDataInterface.ush.
+struct FNTTCharacterRecord
+{
+	// Glyph center in local text space, as in FNTTTextLayout::CharacterPositions
+	FVector2f Position;
+	// Glyph sprite width in the low 16 bits and height in the high 16 bits, as half floats. Zero for characters without a glyph.
+	uint32 SpriteSize = 0;
+	// Line index in the low 16 bits and word index in the high 16 bits, 0xFFFF before the first word
+	uint32 LineAndWord = 0;
+	// USize, VSize, UStart, VStart of the glyph. Zero for characters without a glyph.
+	FVector4f UVs;
+};
+static_assert(sizeof(FNTTCharacterRecord) == 32, "FNTTCharacterRecord is read as two uint4s on the GPU");
+
+// Render-thread registry of GPU text buffers, one per immutable text layout.
+// Instances sharing a cached layout bind the same buffer, so identical text is uploaded once, and an instance whose layout
+// didn't change since the last frame doesn't upload anything.
+//
+// Buffer layout (in floats): glyph indices (int as float bits) and positions (float2) per character, then line starts and line
+// character counts, then word starts and word character counts, then the line and word index of each character, then the line and word
+// character prefix sums. Layouts that parsed markup append a packed color (FColor bits),
+// a scale and a style index per character, and layouts bent along a path a rotation per character; otherwise those sections are empty.
+// Last come the line widths, tops (with vertical alignment applied) and heights, and the bounds of each word (float4), always as full floats.
+//
+// With NTT.TextBuffer.Compact on, buffers are encoded more tightly whenever the layout's values fit: glyph indices, line and word tables
+// and style indices as two uint16s per float, and positions and scales as half floats. The encoding is chosen per buffer and reported
+// through FOffsets::Flags, which the shader reads to decode it.
+//
+// The buffer contents are built by Pack on the game thread when a layout is created, so uploading one is a single copy.
+//
+// With NTT.TextBuffer.CharacterRecords on, layouts packed with their glyph table also get a second buffer of FNTTCharacterRecords,
+// read by the shader as two uint4s per character, so fetching a character's position, sprite size, UVs, line and word
+// takes two loads instead of chasing the glyph index into the glyph buffer.
+class NIAGARATEXTTOOLKIT_API FNTTTextBufferRegistry
+{
+public:
+	static FNTTTextBufferRegistry& Get();
+
+	// Glyph indices, line and word tables, per-character line and word indices, prefix sums and style indices are packed as two uint16s per float
+	static constexpr uint32 Flag_CompactIndices = 1u << 0;
+	// Positions (both components in one float), scales and rotations are stored as half floats
+	static constexpr uint32 Flag_HalfPositions = 1u << 1;
+
+	struct FOffsets
+	{
+		uint32 GlyphIndices = 0;
+		uint32 Positions = 0;
+		uint32 LineStart = 0;
+		uint32 LineCount = 0;
+		uint32 WordStart = 0;
+		uint32 WordCount = 0;
+		uint32 CharacterLines = 0;
+		uint32 CharacterWords = 0;
+		uint32 LinePrefixSums = 0;
+		uint32 WordPrefixSums = 0;
+		uint32 WordPrefixSumsWithWhitespace = 0;
+		uint32 Colors = 0;
+		uint32 Scales = 0;
+		uint32 Styles = 0;
+		uint32 Rotations = 0;
+		uint32 LineWidths = 0;
+		uint32 LineTops = 0;
+		uint32 LineHeights = 0;
+		uint32 WordBounds = 0;
+		uint32 TotalFloats = 0;
+		uint32 Flags = 0;
+	};
+
+	static FOffsets GetOffsets(uint32 NumChars, uint32 NumLines, uint32 NumWords, uint32 NumStyledChars, uint32 NumRotatedChars, uint32 Flags = 0);
+
+	// The most compact encoding Layout's values fit in
+	static uint32 GetCompactFlags(const FNTTTextLayout& Layout);
+
+	// Packs Layout into the contents of its text buffer, and its character records when GlyphTable is the table it was laid out with.
+	// Any thread; store the result in FNTTTextLayout::Packed before publishing the layout.
+	static TSharedRef<const FNTTPackedLayout, ESPMode::ThreadSafe> Pack(const FNTTTextLayout& Layout, const FNTTGlyphTable* GlyphTable = nullptr);
+
+	// Builds one record per character of Layout, matching what the separate sections and the glyph buffer give for it.
+	// Returns false, leaving OutRecords empty, when the text has too many characters for the record's 16-bit line and word indices.
+	static bool PackCharacterRecords(const FNTTTextLayout& Layout, const FNTTGlyphTable& GlyphTable, TArray<FNTTCharacterRecord>& OutRecords);
+
+	// Adds a reference to the buffers for Layout, creating and uploading them on first use. Render thread only.
+	// OutOffsets receives the text buffer's layout, which depends on the encoding chosen when the layout was packed.
+	// OutRecordSRV receives the character record buffer, or null when the layout was packed without one.
+	// GlyphTable is the table Layout was laid out with, used to build its records when the layout has to be packed here.
+	FShaderResourceViewRHIRef AddRef(FRHICommandListBase& RHICmdList, const FNTTTextLayoutPtr& Layout, const FNTTGlyphTable* GlyphTable, FOffsets& OutOffsets, FShaderResourceViewRHIRef& OutRecordSRV);
+
+	// Drops a reference added by AddRef. The buffer is released once no instance references it. Render thread only.
+	void Release(const FNTTTextLayoutPtr& Layout);
+
+private:
+	struct FEntry
+	{
+		// Keeps the layout (and therefore the map key) alive while the buffer exists
+		FNTTTextLayoutPtr Layout;
+		FRWBufferStructured Buffer;
+		FRWBufferStructured RecordBuffer;
+		TSharedPtr<const FNTTPackedLayout, ESPMode::ThreadSafe> Packed;
+		int32 RefCount = 0;
+	};
+
+	TMap<const FNTTTextLayout*, FEntry> Entries;
+};
+
+// A layout packed into the exact contents of its GPU text buffer. Never modified once built.
+struct FNTTPackedLayout
+{
+	FNTTTextBufferRegistry::FOffsets Offsets;
+	// At least one float, so empty text still gets a valid buffer
+	TArray<float> Data;
+	// One per character, or empty when the layout was packed without character records
+	TArray<FNTTCharacterRecord> Records;
+};
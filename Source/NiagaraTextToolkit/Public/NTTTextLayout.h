@@ -0,0 +1,282 @@
+// Property of Lucian Tranc
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NTTFontCache.h"
+#include "NTTTextLayout.generated.h"
+
+struct FNTTPackedLayout;
+
+UENUM(BlueprintType)
+enum class ENTTTextVerticalAlignment : uint8
+{
+	NTT_TVA_Top		UMETA(DisplayName = "Top"),
+	NTT_TVA_Center	UMETA(DisplayName = "Center"),
+	NTT_TVA_Bottom	UMETA(DisplayName = "Bottom"),
+};
+
+UENUM(BlueprintType)
+enum class ENTTTextHorizontalAlignment : uint8
+{
+	NTT_THA_Left	UMETA(DisplayName = "Left"),
+	NTT_THA_Center	UMETA(DisplayName = "Center"),
+	NTT_THA_Right	UMETA(DisplayName = "Right"),
+};
+
+UENUM(BlueprintType)
+enum class ENTTTextPathMode : uint8
+{
+	NTT_TPM_None	UMETA(DisplayName = "None"),
+	NTT_TPM_Arc		UMETA(DisplayName = "Arc"),
+	NTT_TPM_Path	UMETA(DisplayName = "Path"),
+};
+
+// Layout options, mirrored from the data interface properties
+struct FNTTTextLayoutSettings
+{
+	ENTTTextHorizontalAlignment HorizontalAlignment = ENTTTextHorizontalAlignment::NTT_THA_Center;
+	ENTTTextVerticalAlignment VerticalAlignment = ENTTTextVerticalAlignment::NTT_TVA_Center;
+	// Extra spacing between lines
+	float VerticalOffset = 0.0f;
+	// Extra spacing between characters, added to the font's kerning
+	float KerningOffset = 0.0f;
+	float WhitespaceWidthMultiplier = 1.0f;
+	bool bFilterWhitespaceCharacters = true;
+	// Lines are wrapped at word boundaries so they fit within this width, in pixels. 0 disables wrapping.
+	float MaxLineWidth = 0.0f;
+	// Treat <c=#RRGGBB>, <s=Scale> and <style=Name> tags (and their closing tags) as markup rather than text
+	bool bParseMarkup = false;
+	// Names accepted by <style=Name>. A character's style index is the position of its style in this list.
+	TArray<FName> MarkupStyles;
+	// Bends the laid out text along an arc or a polyline path, baking each character's position and rotation
+	ENTTTextPathMode PathMode = ENTTTextPathMode::NTT_TPM_None;
+	// Arc radius in pixels. Positive radii curve the text around a center below it, negative ones around a center above it.
+	float ArcRadius = 0.0f;
+	// Rotates the text around the arc's center, in degrees clockwise
+	float ArcStartAngle = 0.0f;
+	// Path points in layout space (pixels, +X right, +Y down). The text origin sits at the path's start, middle or end to match the horizontal alignment.
+	TArray<FVector2f> PathPoints;
+
+	bool operator==(const FNTTTextLayoutSettings& Other) const
+	{
+		return HorizontalAlignment == Other.HorizontalAlignment
+			&& VerticalAlignment == Other.VerticalAlignment
+			&& VerticalOffset == Other.VerticalOffset
+			&& KerningOffset == Other.KerningOffset
+			&& WhitespaceWidthMultiplier == Other.WhitespaceWidthMultiplier
+			&& bFilterWhitespaceCharacters == Other.bFilterWhitespaceCharacters
+			&& MaxLineWidth == Other.MaxLineWidth
+			&& bParseMarkup == Other.bParseMarkup
+			&& MarkupStyles == Other.MarkupStyles
+			&& PathMode == Other.PathMode
+			&& ArcRadius == Other.ArcRadius
+			&& ArcStartAngle == Other.ArcStartAngle
+			&& PathPoints == Other.PathPoints;
+	}
+};
+
+// Per-character, per-line and per-word tables produced by the layout engine.
+// Character indices refer to the output characters (after whitespace filtering), not the source string.
+struct FNTTTextLayout
+{
+	TArray<int32> Unicode;
+	// Per-character index into the glyph table, INDEX_NONE for characters the font has no glyph for
+	TArray<int32> GlyphIndices;
+	// Per-character glyph center in local text space (pixels, +X right, +Y down)
+	TArray<FVector2f> CharacterPositions;
+	TArray<int32> LineStartIndices;
+	TArray<int32> LineCharacterCounts;
+	TArray<int32> WordStartIndices;
+	TArray<int32> WordCharacterCounts;
+	float TotalTextHeight = 0.0f;
+
+	// Per-character index of the line and word containing it, so per-line and per-word effects don't have to search the start index tables.
+	// Unfiltered whitespace between words belongs to the word before it; characters before the first word have INDEX_NONE.
+	TArray<int32> CharacterLineIndices;
+	TArray<int32> CharacterWordIndices;
+
+	// Exclusive prefix sums of the characters in each line and word, with one more entry than there are lines or words,
+	// so the characters in an inclusive range [A, B] are Sums[B + 1] - Sums[A]. The word sums come with and without the whitespace after each word.
+	TArray<int32> LineCharacterPrefixSums;
+	TArray<int32> WordCharacterPrefixSums;
+	TArray<int32> WordCharacterPrefixSumsWithWhitespace;
+
+	// Per-character style streams from markup. Empty unless markup parsing is on, otherwise one entry per character.
+	// Color is as written in the markup (sRGB), scale multiplies the glyph's size and advance, and style is an index into
+	// FNTTTextLayoutSettings::MarkupStyles or INDEX_NONE.
+	TArray<FColor> CharacterColors;
+	TArray<float> CharacterScales;
+	TArray<int32> CharacterStyles;
+
+	// Per-character rotation in radians, clockwise in layout space, from bending the text along a path. Empty when the text is straight.
+	TArray<float> CharacterRotations;
+
+	// Per-word box around its drawn glyphs as (MinX, MinY, MaxX, MaxY) in final layout space, and the union of every word's box.
+	// Glyph boxes are unrotated, so on a path they are only approximate. A word with no drawn glyphs, and empty text, get a zero box.
+	TArray<FVector4f> WordBounds;
+	FVector4f TextBounds = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+
+	// Per-line state kept so an edited string can be relaid out from its first changed line
+	// Source string index of each line's first character (for wrapped lines, the first character of the wrapped word)
+	TArray<int32> LineSourceStartIndices;
+	// Per-line width and height, and top relative to the top of the block before vertical alignment
+	TArray<float> LineWidths;
+	TArray<float> LineTops;
+	TArray<float> LineHeights;
+	// Vertical alignment offset currently baked into CharacterPositions
+	float BlockOffsetY = 0.0f;
+	// The string and settings this layout was produced from
+	FString SourceText;
+	FNTTTextLayoutSettings Settings;
+	// The layout packed into its GPU text buffer, built before the layout is published so the render thread only has to copy it
+	TSharedPtr<const FNTTPackedLayout, ESPMode::ThreadSafe> Packed;
+
+	// Empties every table but keeps the allocations
+	void Reset();
+
+	// Heap memory held by the layout's tables, in bytes
+	SIZE_T GetAllocatedSize() const;
+};
+
+// Layouts are immutable once published, so instances showing the same text can share one.
+typedef TSharedPtr<const FNTTTextLayout, ESPMode::ThreadSafe> FNTTTextLayoutPtr;
+
+// Layout results for several strings, stored back to back in shared arrays.
+// Each string's slice holds the core per-character, per-line and per-word tables of an FNTTTextLayout, with line and word start indices
+// relative to the string's first character. Prefix sums, line metrics, word and text bounds and the packed GPU buffer are not kept;
+// text meant for a data interface goes through FNTTTextLayoutEngine::Layout instead.
+struct FNTTTextLayoutBatch
+{
+	struct FRange
+	{
+		int32 CharacterStart = 0;
+		int32 NumCharacters = 0;
+		int32 LineStart = 0;
+		int32 NumLines = 0;
+		int32 WordStart = 0;
+		int32 NumWords = 0;
+		float TotalTextHeight = 0.0f;
+	};
+
+	// One entry per input string, in input order
+	TArray<FRange> Ranges;
+	TArray<int32> Unicode;
+	TArray<int32> GlyphIndices;
+	TArray<FVector2f> CharacterPositions;
+	TArray<int32> LineStartIndices;
+	TArray<int32> LineCharacterCounts;
+	TArray<int32> WordStartIndices;
+	TArray<int32> WordCharacterCounts;
+	// Relative to the string's first line and word, like the start indices
+	TArray<int32> CharacterLineIndices;
+	TArray<int32> CharacterWordIndices;
+	// Filled only when the settings parse markup, with the same slices as the per-character arrays
+	TArray<FColor> CharacterColors;
+	TArray<float> CharacterScales;
+	TArray<int32> CharacterStyles;
+	// Filled only when the settings bend the text along a path
+	TArray<float> CharacterRotations;
+};
+
+// Formatting options for numbers shown through the numeric fast path (see UNTTDataInterface::SetNumber)
+USTRUCT(BlueprintType)
+struct FNTTNumberFormat
+{
+	GENERATED_BODY()
+
+	// The integer part is zero-padded to at least this many digits, which keeps the character count steady for counters
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Number Format", meta = (DisplayName = "Minimum Integer Digits", ClampMin = "1", ClampMax = "19"))
+	int32 MinimumIntegerDigits = 1;
+
+	// Digits after the decimal point. Only used for floating point values.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Number Format", meta = (DisplayName = "Fractional Digits", ClampMin = "0", ClampMax = "9"))
+	int32 FractionalDigits = 0;
+
+	// Separates groups of three integer digits with commas
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Number Format", meta = (DisplayName = "Use Grouping"))
+	bool bUseGrouping = false;
+
+	// Shows a '+' in front of positive values, as is usual for damage and score popups
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Number Format", meta = (DisplayName = "Always Show Sign"))
+	bool bAlwaysShowSign = false;
+};
+
+// A number formatted into a fixed-size character buffer, so it can be laid out without building an FString
+struct NIAGARATEXTTOOLKIT_API FNTTNumberText
+{
+	// Sign, 19 digits, 6 group separators, the decimal point and 9 fractional digits
+	static constexpr int32 MaxChars = 36;
+
+	TCHAR Chars[MaxChars];
+	int32 Len = 0;
+
+	static FNTTNumberText FromInteger(int64 Value, const FNTTNumberFormat& Format);
+	// Rounds to Format.FractionalDigits. Values too large for an int64 once scaled are clamped, and NaN shows as 0.
+	static FNTTNumberText FromFloat(double Value, const FNTTNumberFormat& Format);
+
+	bool operator==(const FNTTNumberText& Other) const
+	{
+		return Len == Other.Len && FMemory::Memcmp(Chars, Other.Chars, Len * sizeof(TCHAR)) == 0;
+	}
+};
+
+// Metrics of the few glyphs a formatted number can use, looked up once per glyph table so numbers are laid out without touching the page table
+struct FNTTNumberGlyphs
+{
+	// Digits 0-9, then '+', '-', '.' and ','
+	static constexpr int32 NumSlots = 14;
+
+	int32 GlyphIndices[NumSlots];
+	FVector2f Sizes[NumSlots];
+	float TopYs[NumSlots];
+	float Kerning = 0.0f;
+	float MaxGlyphHeight = 0.0f;
+	bool bHasGlyphs = false;
+	bool bBuilt = false;
+
+	void Build(const FNTTGlyphTable& GlyphTable);
+
+	// Slot for a character produced by FNTTNumberText
+	static FORCEINLINE int32 GetSlot(TCHAR Ch)
+	{
+		switch (Ch)
+		{
+			case '+': return 10;
+			case '-': return 11;
+			case '.': return 12;
+			case ',': return 13;
+			default: return Ch - '0';
+		}
+	}
+};
+
+// Lays out text against a glyph table.
+// Line measuring, word wrapping, word segmentation and whitespace filtering all happen in a single forward scan over the source string;
+// without wrapping, X positions are resolved per line by a vectorized prefix sum, and alignment is then applied as a cheap per-line fixup over the output.
+class NIAGARATEXTTOOLKIT_API FNTTTextLayoutEngine
+{
+public:
+	// Writes into OutLayout's existing arrays, so laying out into a reused layout only allocates when the text outgrows it.
+	static void Layout(const FNTTGlyphTable& GlyphTable, const FNTTTextLayoutSettings& Settings, const FString& InputText, FNTTTextLayout& OutLayout);
+
+	// Brings a layout previously produced with the same glyph table up to date with InputText.
+	// Lines before the first edited one are kept; only the vertical alignment shift is reapplied to them if the block height changed.
+	// Falls back to a full layout if the settings changed, if they parse markup, as style tags carry over from earlier lines,
+	// or if they bend the text along a path, as the path moves every character when the block's alignment shifts.
+	static void Relayout(const FNTTGlyphTable& GlyphTable, const FNTTTextLayoutSettings& Settings, const FString& InputText, FNTTTextLayout& InOutLayout);
+
+	// Lays out every string in InputTexts with the same glyph table and settings, splitting the strings across worker threads.
+	// OutBatch's arrays are reused, so laying out a similar batch every frame doesn't allocate. Meant for code that positions many short labels
+	// itself; the data interface doesn't use it, as each of its instances lays out and caches a full FNTTTextLayout.
+	static void LayoutBatch(const FNTTGlyphTable& GlyphTable, const FNTTTextLayoutSettings& Settings, TArrayView<const FString> InputTexts, FNTTTextLayoutBatch& OutBatch);
+
+	// Lays out a formatted number as a single line, from metrics built for the glyph table the layout is for.
+	// Positions match what Layout would produce for the same characters, in one pass over at most FNTTNumberText::MaxChars characters.
+	// Markup isn't parsed, so the layout has no color, scale or style streams even when Settings parse markup.
+	static void LayoutNumber(const FNTTNumberGlyphs& NumberGlyphs, const FNTTTextLayoutSettings& Settings, const FNTTNumberText& Number, FNTTTextLayout& OutLayout);
+
+	// Allocates a layout to be shared. When the last reference goes away its arrays return to a small pool rather than the heap,
+	// so the next allocation (typically the same system being reinitialized with new text) starts with warm allocations.
+	static TSharedRef<FNTTTextLayout, ESPMode::ThreadSafe> AllocateLayout();
+};
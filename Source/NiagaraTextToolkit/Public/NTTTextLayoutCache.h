@@ -0,0 +1,48 @@
+// Property of Lucian Tranc
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "NTTFontCache.h"
+#include "NTTTextLayout.h"
+
+// Process-wide cache of immutable text layouts, keyed by a hash of (glyph table, text, layout settings).
+// Instances showing the same text with the same settings share one layout, and through it one GPU text buffer (see FNTTTextBufferRegistry).
+// Least recently used entries are evicted once the cached layouts exceed NTT.LayoutCache.MaxSizeKB; instances holding an evicted layout keep it alive.
+class NIAGARATEXTTOOLKIT_API FNTTTextLayoutCache
+{
+public:
+	static FNTTTextLayoutCache& Get();
+
+	// Hash of the text and layout settings, independent of the font
+	static uint64 HashText(const FString& Text, const FNTTTextLayoutSettings& Settings);
+
+	// Combines a HashText result with the glyph table to form the cache key
+	static uint64 MakeKey(const FNTTGlyphTablePtr& GlyphTable, uint64 TextHash);
+
+	// Returns the cached layout for Key, or nullptr. The layout's text and settings are checked so a hash collision is never returned.
+	FNTTTextLayoutPtr Find(uint64 Key, const FNTTGlyphTablePtr& GlyphTable, const FString& Text, const FNTTTextLayoutSettings& Settings);
+
+	// Caches Layout under Key, evicting the least recently used layouts if the cache is over budget.
+	void Add(uint64 Key, const FNTTGlyphTablePtr& GlyphTable, const FNTTTextLayoutPtr& Layout);
+
+	void Empty();
+
+private:
+	FNTTTextLayoutCache();
+
+	void EvictToBudget(SIZE_T MaxBytes);
+
+	struct FEntry
+	{
+		// Keeps the glyph table alive so its address can't be reused by another table while this entry exists
+		FNTTGlyphTablePtr GlyphTable;
+		FNTTTextLayoutPtr Layout;
+		SIZE_T SizeBytes = 0;
+	};
+
+	FCriticalSection CacheLock;
+	TLruCache<uint64, FEntry> Entries;
+	SIZE_T TotalBytes = 0;
+};
@@ -9,6 +9,7 @@
 #include "Engine/Font.h"
 #include "Engine/Texture2D.h"
 #include "Engine/DataAsset.h"
+#include "Components/SplineComponent.h"
 #include "NTTDataInterface.h"
 #include "NiagaraTextToolkitHelpers.generated.h"
 
@@ -19,12 +20,29 @@ class NIAGARATEXTTOOLKIT_API UNiagaraTextToolkitHelpers : public UBlueprintFunct
 
 public:
 
+	// Layout Mode chooses whether text missing from the layout cache is laid out right away or on a worker thread; Default uses the data interface's Async Layout.
 	UFUNCTION(BlueprintCallable, Category = "Niagara Text Toolkit Plugin", meta = (DisplayName = "Set Niagara Variable (NTT Text)"))
-	static void SetNiagaraNTTTextVariable(UNiagaraComponent* System, FString TextToDisplay);
+	static void SetNiagaraNTTTextVariable(UNiagaraComponent* System, FString TextToDisplay, ENTTLayoutMode LayoutMode = ENTTLayoutMode::NTT_LM_Default);
+
+	// Shows an integer without building a string or reinitializing the system. Meant for counters and damage numbers updated every frame.
+	UFUNCTION(BlueprintCallable, Category = "Niagara Text Toolkit Plugin", meta = (DisplayName = "Set Niagara Variable (NTT Integer)"))
+	static void SetNiagaraNTTIntegerVariable(UNiagaraComponent* System, int64 Value, FNTTNumberFormat Format);
+
+	// Shows a float rounded to Format's fractional digits, without building a string or reinitializing the system.
+	UFUNCTION(BlueprintCallable, Category = "Niagara Text Toolkit Plugin", meta = (DisplayName = "Set Niagara Variable (NTT Float)"))
+	static void SetNiagaraNTTFloatVariable(UNiagaraComponent* System, double Value, FNTTNumberFormat Format);
 
 	UFUNCTION(BlueprintCallable, Category = "Niagara Text Toolkit Plugin", meta = (DisplayName = "Set Niagara Variable (NTT Font)"))
 	static void SetNiagaraNTTFontVariable(UNiagaraComponent* System, UFont* Font);
 
+	UFUNCTION(BlueprintCallable, Category = "Niagara Text Toolkit Plugin", meta = (DisplayName = "Set Niagara Variable (NTT Font Metrics)"))
+	static void SetNiagaraNTTFontMetricsVariable(UNiagaraComponent* System, UNTTFontMetrics* FontMetrics);
+
+	// Bends the text along Spline: samples it into Path Points, evenly spaced by distance, and sets Path Mode to Path.
+	// The spline is read relative to the Niagara component, on the plane the text is drawn in.
+	UFUNCTION(BlueprintCallable, Category = "Niagara Text Toolkit Plugin", meta = (DisplayName = "Set Niagara Variable (NTT Path From Spline)"))
+	static void SetNiagaraNTTPathFromSpline(UNiagaraComponent* System, USplineComponent* Spline, int32 NumSamples = 64);
+
 private:
 
 	static UNTTDataInterface* FindNTTDataInterface(UNiagaraComponent* System);
@@ -15,6 +15,8 @@
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Engine/Font.h"
 #include "Engine/Texture2D.h"
+#include "NTTFontCache.h"
+#include "NTTFontMetrics.h"
 
 bool UNiagaraTextToolkitEditorHelpers::SaveFontTexturesToAssets(UFont* FontAsset, const FString& FontAssetPath)
 {
@@ -144,6 +146,87 @@ bool UNiagaraTextToolkitEditorHelpers::SaveFontTexturesToAssets(UFont* FontAsset
 	return bAllSuccessful;
 }
 
+bool UNiagaraTextToolkitEditorHelpers::BakeFontMetricsToAsset(UFont* FontAsset, const FString& FontAssetPath)
+{
+	if (!FontAsset)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UNiagaraTextToolkitEditorHelpers::BakeFontMetricsToAsset: FontAsset is null"));
+		return false;
+	}
+
+	FNTTGlyphTable GlyphTable;
+	if (!FNTTFontCache::BuildGlyphTable(FontAsset, GlyphTable))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UNiagaraTextToolkitEditorHelpers::BakeFontMetricsToAsset: Font '%s' is not an offline cached font"), *FontAsset->GetName());
+		return false;
+	}
+
+	FString PackageName = FPackageName::ObjectPathToPackageName(FontAssetPath);
+	FString PackagePathForValidation = FPackageName::GetLongPackagePath(PackageName);
+	FString ShortName = FPackageName::GetShortName(PackageName);
+	FString AssetName = ShortName.StartsWith(TEXT("F_")) ? TEXT("FM_") + ShortName.RightChop(2) : TEXT("FM_") + ShortName;
+
+	FText InvalidPathReason;
+	if (!FPackageName::IsValidLongPackageName(PackagePathForValidation, false, &InvalidPathReason))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UNiagaraTextToolkitEditorHelpers::BakeFontMetricsToAsset: Invalid package path '%s': %s"), *PackagePathForValidation, *InvalidPathReason.ToString());
+		return false;
+	}
+
+	const FScopedTransaction Transaction(NSLOCTEXT("NiagaraTextToolkit", "BakeFontMetricsToAsset", "Bake Font Metrics To Asset"));
+
+	const FString BasePackageName = PackagePathForValidation + TEXT("/") + AssetName;
+	FString UniquePackageName, UniqueAssetName;
+	{
+		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
+		AssetToolsModule.Get().CreateUniqueAssetName(BasePackageName, TEXT(""), UniquePackageName, UniqueAssetName);
+	}
+
+	UPackage* Package = CreatePackage(*UniquePackageName);
+	if (!Package)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UNiagaraTextToolkitEditorHelpers::BakeFontMetricsToAsset: Failed to create package"));
+		return false;
+	}
+	Package->FullyLoad();
+
+	UNTTFontMetrics* FontMetrics = NewObject<UNTTFontMetrics>(Package, *UniqueAssetName, RF_Public | RF_Standalone);
+	FontMetrics->SourceFont = FontAsset;
+	FontMetrics->SetGlyphTable(MoveTemp(GlyphTable));
+	FontMetrics->MarkPackageDirty();
+
+	{
+		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+		AssetRegistryModule.AssetCreated(FontMetrics);
+	}
+
+	bool bSuccessful = true;
+	{
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+
+		const FString PackageFilename = FPackageName::LongPackageNameToFilename(UniquePackageName, FPackageName::GetAssetPackageExtension());
+		if (!UPackage::SavePackage(Package, FontMetrics, *PackageFilename, SaveArgs))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UNiagaraTextToolkitEditorHelpers::BakeFontMetricsToAsset: Save failed for '%s'"), *UniquePackageName);
+			bSuccessful = false;
+		}
+	}
+
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+	ContentBrowserModule.Get().SyncBrowserToAssets(TArray<UObject*>({ FontMetrics }));
+
+	if (bSuccessful)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UNiagaraTextToolkitEditorHelpers::BakeFontMetricsToAsset: Baked %d glyphs from '%s'"), FontMetrics->NumGlyphs, *FontAsset->GetName());
+	}
+
+	ShowSlateNotification(FText::FromString(FString::Printf(TEXT("Font metrics baked to asset at:\n%s"), *UniquePackageName)), 5.0f);
+
+	return bSuccessful;
+}
+
 void UNiagaraTextToolkitEditorHelpers::ShowSlateNotification(const FText& Message, float Duration)
 {
 	FNotificationInfo Info(Message);
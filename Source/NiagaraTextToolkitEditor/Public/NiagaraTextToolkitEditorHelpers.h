@@ -18,6 +18,9 @@ public:
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Niagara Text Toolkit Plugin")
 	static bool SaveFontTexturesToAssets(UFont* FontAsset, const FString& FontAssetPath);
 
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Niagara Text Toolkit Plugin")
+	static bool BakeFontMetricsToAsset(UFont* FontAsset, const FString& FontAssetPath);
+
 private:
 
 	static void ShowSlateNotification(const FText& Message, float Duration = 3.0f);